@@ -0,0 +1,37 @@
+#include "apa102.h"
+#include "apa102Encoder.h"
+#include "config.h"
+
+namespace apa102 {
+  static uint8_t buffer[apa102Encoder::encodedLength(NUM_LEDS)];
+  static volatile bool sending;
+
+  //called from the DMA interrupt
+  static void onSent() {
+    sending = false;
+  }
+
+  void setup() {
+    LED_SPI.begin();
+    LED_SPI.setBitOrder(MSBFIRST);
+    LED_SPI.setDataMode(SPI_MODE0);
+    LED_SPI.setClockSpeed(APA102_SPI_CLOCK_HZ);
+
+    sending = false;
+  }
+
+  void send(const uint8_t *values, uint32_t numLeds) {
+    if (sending) {
+      return;
+    }
+
+    if (numLeds > NUM_LEDS) {
+      numLeds = NUM_LEDS;
+    }
+
+    const uint32_t frameBytes = apa102Encoder::encode(buffer, values, numLeds, APA102_BRIGHTNESS);
+
+    sending = true;
+    LED_SPI.transfer(buffer, nullptr, frameBytes, onSent);
+  }
+}
@@ -0,0 +1,23 @@
+#ifndef OBELISK_APA102_H
+#define OBELISK_APA102_H
+
+#include "Particle.h"
+
+/*
+ * Drives an APA102/SK9822 strip from the SPI port's clock and MOSI pins, the
+ * frame is encoded by apa102Encoder and sent by DMA so the render thread
+ * doesn't wait on it.
+ */
+namespace apa102 {
+  void setup();
+
+  /**
+   * Encode and start sending a frame. A frame that arrives while the last is still
+   * being sent is dropped rather than waited for.
+   * @param values 3 bytes per LED in the strip's colour order
+   * @param numLeds number of LEDs, at most NUM_LEDS
+   */
+  void send(const uint8_t *values, uint32_t numLeds);
+}
+
+#endif
@@ -0,0 +1,52 @@
+#include "apa102Encoder.h"
+
+#define LED_FRAME_MARKER 0xE0
+#define GLOBAL_MAX 31
+
+namespace apa102Encoder {
+  /*
+   * ceil(31 * 2^16 / (255 * global)), scales a channel times the master brightness to 8 bits at
+   * each global. Rounding up keeps full scale at 255 and adds less than one to any channel, which
+   * the global chosen for the brightest channel leaves room for.
+   */
+  static const uint16_t GLOBAL_SCALE[GLOBAL_MAX + 1] = {
+    0, 7968, 3984, 2656, 1992, 1594, 1328, 1139, 996, 886, 797, 725, 664, 613, 570, 532,
+    498, 469, 443, 420, 399, 380, 363, 347, 332, 319, 307, 296, 285, 275, 266, 258,
+  };
+
+  static inline uint8_t max3(uint8_t a, uint8_t b, uint8_t c) {
+    const uint8_t ab = a > b ? a : b;
+    return ab > c ? ab : c;
+  }
+
+  uint32_t encode(uint8_t *output, const uint8_t *values, uint32_t numLeds, uint8_t brightness) {
+    uint8_t *out = output;
+
+    for (uint32_t i=0; i < APA102_START_FRAME_BYTES; i++) {
+      *out++ = 0;
+    }
+
+    for (uint32_t i=0; i < numLeds; i++) {
+      const uint8_t *src = &values[i * 3];
+      const uint32_t peak = max3(src[0], src[1], src[2]) * (uint32_t)brightness;
+
+      //smallest global that shows the brightest channel without exceeding 255, rounded up
+      const uint32_t global = (peak * GLOBAL_MAX + 255 * 255 - 1) / (255 * 255);
+      const uint32_t scale = GLOBAL_SCALE[global] * (uint32_t)brightness;
+
+      out[0] = (uint8_t)(LED_FRAME_MARKER | global);
+      out[1] = (uint8_t)((src[0] * scale) >> 16);
+      out[2] = (uint8_t)((src[1] * scale) >> 16);
+      out[3] = (uint8_t)((src[2] * scale) >> 16);
+      out += 4;
+    }
+
+    const uint32_t endBytes = endFrameLength(numLeds);
+
+    for (uint32_t i=0; i < endBytes; i++) {
+      *out++ = 0;
+    }
+
+    return out - output;
+  }
+}
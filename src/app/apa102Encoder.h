@@ -0,0 +1,37 @@
+#ifndef OBELISK_APA102_ENCODER_H
+#define OBELISK_APA102_ENCODER_H
+
+#include "Particle.h"
+
+/* Zero bytes before the first LED */
+#define APA102_START_FRAME_BYTES 4
+
+/*
+ * Encodes frames for clocked LEDs (APA102, SK9822): a start frame, then 4 bytes
+ * per LED holding a 5 bit brightness and the three channels, then an end frame
+ * that clocks the data through to the last LED.
+ */
+namespace apa102Encoder {
+  /* Zero bytes after the last LED, half a clock per LED for the APA102 plus a latch frame for the SK9822 */
+  constexpr uint32_t endFrameLength(uint32_t numLeds) {
+    return (numLeds + 15) / 16 + 4;
+  }
+
+  /* Bytes of SPI data for a frame of numLeds LEDs */
+  constexpr uint32_t encodedLength(uint32_t numLeds) {
+    return APA102_START_FRAME_BYTES + numLeds * 4 + endFrameLength(numLeds);
+  }
+
+  /**
+   * Encode a frame in a single pass. Each LED's 5 bit brightness is the lowest
+   * that can show it at the master brightness, and the channels are scaled up to
+   * match, so dim colours keep their full 8 bits of resolution.
+   * @param output encodedLength(numLeds) bytes
+   * @param values 3 bytes per LED, in the strip's colour order
+   * @param brightness master brightness, 255 = full
+   * @return number of bytes written
+   */
+  uint32_t encode(uint8_t *output, const uint8_t *values, uint32_t numLeds, uint8_t brightness);
+}
+
+#endif
@@ -55,15 +55,15 @@ namespace argParser {
       const ArgInfo *info = &config->info[i];
 
       if (info->type == ARG_TYPE_NUMBER) {
-        int32_t value;
-        int32_t result = strToInt((uint32_t*)&value, *arg);
+        uint32_t value;
+        int32_t result = strToInt(&value, *arg);
 
-        if (result != 0 || value < info->min || value > info->max) {
+        if (result != 0 || (int64_t)value < info->min || (int64_t)value > info->max) {
           return RET_VAL_INVALID_ARG;
         }
       } else {
-        Colour col = Colour(*arg);
-        if (!col.isValid()) {
+        Colour col;
+        if (!Colour::parse(*arg, &col)) {
           return RET_VAL_INVALID_ARG;
         }
       }
@@ -71,4 +71,77 @@ namespace argParser {
 
     return 0;
   }
+
+  int32_t parseArgs(uint32_t* values, const ArgConfig* config, String args) {
+    String parsedArgs[ARG_COUNT_MAX];
+    int32_t result;
+
+    if (config->length > ARG_COUNT_MAX) {
+      return RET_VAL_TOO_MANY_ARGS;
+    }
+
+    result = parseAndValidateArgs(parsedArgs, config, args);
+
+    if (result != RET_VAL_SUC) {
+      return result;
+    }
+
+    for (uint32_t i=0; i<config->length; i++) {
+      if (config->info[i].type == ARG_TYPE_NUMBER) {
+        strToInt(&values[i], parsedArgs[i]);
+      } else {
+        Colour col;
+        Colour::parse(parsedArgs[i], &col);
+        values[i] = col.packed();
+      }
+    }
+
+    return RET_VAL_SUC;
+  }
+
+  uint32_t packedSize(const ArgInfo* info) {
+    if (info->type == ARG_TYPE_COLOUR) {
+      return 3;
+    }
+
+    if (info->max <= UINT8_MAX) {
+      return 1;
+    }
+
+    if (info->max <= UINT16_MAX) {
+      return 2;
+    }
+
+    return 4;
+  }
+
+  uint32_t packArgs(uint8_t* output, const ArgConfig* config, const uint32_t* values) {
+    uint32_t length = 0;
+
+    for (uint32_t i=0; i<config->length; i++) {
+      const uint32_t size = packedSize(&config->info[i]);
+
+      //little endian, least significant byte first
+      for (uint32_t j=0; j<size; j++) {
+        output[length++] = (uint8_t)(values[i] >> (8 * j));
+      }
+    }
+
+    return length;
+  }
+
+  uint32_t unpackArgs(uint32_t* values, const ArgConfig* config, const uint8_t* input) {
+    uint32_t length = 0;
+
+    for (uint32_t i=0; i<config->length; i++) {
+      const uint32_t size = packedSize(&config->info[i]);
+
+      values[i] = 0;
+      for (uint32_t j=0; j<size; j++) {
+        values[i] |= (uint32_t)input[length++] << (8 * j);
+      }
+    }
+
+    return length;
+  }
 }
@@ -14,6 +14,9 @@ namespace argParser {
   const int32_t  RET_VAL_TOO_MANY_ARGS = -2;
   const int32_t  RET_VAL_INVALID_ARG = -3;
 
+  /* Longest argument list supported by parseArgs() */
+  const uint32_t ARG_COUNT_MAX = 10;
+
   #define ARG_TYPE_NUMBER 0
   #define ARG_TYPE_COLOUR 1
 
@@ -30,6 +33,30 @@ namespace argParser {
 
 
   int32_t parseAndValidateArgs(String* output, const ArgConfig* config, String args);
+
+  /**
+   * Parse and validate arguments into values. Numbers are stored as is and
+   * colours as 0xRRGGBB.
+   * @param values Array of values.  Size must be at least config->length.
+   * @return RET_VAL_SUC on success, error code on failure
+   */
+  int32_t parseArgs(uint32_t* values, const ArgConfig* config, String args);
+
+  /* Number of bytes used to store an argument, numbers use the fewest bytes that fit info->max */
+  uint32_t packedSize(const ArgInfo* info);
+
+  /**
+   * Store parsed values in packed form
+   * @param output Buffer of at least the sum of packedSize() for each argument
+   * @return number of bytes written
+   */
+  uint32_t packArgs(uint8_t* output, const ArgConfig* config, const uint32_t* values);
+
+  /**
+   * Restore values stored by packArgs()
+   * @return number of bytes read
+   */
+  uint32_t unpackArgs(uint32_t* values, const ArgConfig* config, const uint8_t* input);
 }
 
 #endif
@@ -0,0 +1,82 @@
+#include "clockSync.h"
+
+ClockSync::ClockSync() {
+  reset();
+}
+
+void ClockSync::reset() {
+  mLocked = false;
+  mBaseLocalMs = 0;
+  mBaseSharedMs = 0;
+  mRatePpm = 0;
+  mAnchorLocalMs = 0;
+  mAnchorSharedMs = 0;
+  mLastNowMs = 0;
+}
+
+uint64_t ClockSync::project(uint32_t localMs) {
+  const uint32_t elapsedMs = localMs - mBaseLocalMs;
+
+  return mBaseSharedMs + elapsedMs + ((int64_t)elapsedMs * mRatePpm) / 1000000;
+}
+
+void ClockSync::step(uint32_t localMs, uint64_t sharedMs) {
+  mLocked = true;
+  mBaseLocalMs = localMs;
+  mBaseSharedMs = sharedMs;
+  mAnchorLocalMs = localMs;
+  mAnchorSharedMs = sharedMs;
+  mLastNowMs = sharedMs;
+}
+
+bool ClockSync::sample(uint32_t localMs, uint64_t sharedMs) {
+  if (!mLocked) {
+    mRatePpm = 0;
+    step(localMs, sharedMs);
+    return true;
+  }
+
+  const uint64_t predictedMs = project(localMs);
+  const int64_t errorMs = (int64_t)(sharedMs - predictedMs);
+  const uint32_t spanMs = localMs - mAnchorLocalMs;
+
+  //too far out to slew, eg the reference was corrected by the cloud
+  if (errorMs > CLOCK_SYNC_STEP_THRESHOLD_MS || errorMs < -CLOCK_SYNC_STEP_THRESHOLD_MS) {
+    step(localMs, sharedMs);
+    return true;
+  }
+
+  if (spanMs >= CLOCK_SYNC_RATE_SPAN_MIN_MS) {
+    int64_t ratePpm = (((int64_t)(sharedMs - mAnchorSharedMs) - spanMs) * 1000000) / spanMs;
+
+    ratePpm = ratePpm > CLOCK_SYNC_RATE_MAX_PPM ? CLOCK_SYNC_RATE_MAX_PPM : ratePpm;
+    ratePpm = ratePpm < -CLOCK_SYNC_RATE_MAX_PPM ? -CLOCK_SYNC_RATE_MAX_PPM : ratePpm;
+    mRatePpm = (int32_t)ratePpm;
+  }
+
+  mBaseSharedMs = predictedMs + errorMs / CLOCK_SYNC_PHASE_GAIN;
+  mBaseLocalMs = localMs;
+
+  //move the anchor up before the local counter can wrap under it
+  if (spanMs >= CLOCK_SYNC_RATE_SPAN_MAX_MS) {
+    mAnchorLocalMs = localMs;
+    mAnchorSharedMs = mBaseSharedMs;
+  }
+
+  return false;
+}
+
+uint64_t ClockSync::now(uint32_t localMs) {
+  if (!mLocked) {
+    return localMs;
+  }
+
+  const uint64_t nowMs = project(localMs);
+
+  //a negative phase correction holds time still rather than running it backwards
+  if (nowMs > mLastNowMs) {
+    mLastNowMs = nowMs;
+  }
+
+  return mLastNowMs;
+}
@@ -0,0 +1,57 @@
+#ifndef OBELISK_CLOCK_SYNC_H
+#define OBELISK_CLOCK_SYNC_H
+
+#include "Particle.h"
+
+#define CLOCK_SYNC_STEP_THRESHOLD_MS 500
+#define CLOCK_SYNC_RATE_MAX_PPM 1000
+#define CLOCK_SYNC_PHASE_GAIN 4
+#define CLOCK_SYNC_RATE_SPAN_MIN_MS 60000
+#define CLOCK_SYNC_RATE_SPAN_MAX_MS 86400000
+
+#define MS_PER_DAY 86400000ULL
+
+/*
+ * Shared time base for keeping several units in phase. The local millisecond
+ * counter is disciplined against samples of a reference clock (unix time in
+ * ms, learned from the cloud time sync) by a small phase-locked loop. Each
+ * sample corrects a fraction of the phase error, which averages out the jitter
+ * of sampling on a tick. The rate is measured against an anchor sample at
+ * least a minute old, so the local crystal's drift is tracked between samples
+ * without the per-sample jitter swamping it.
+ */
+class ClockSync {
+private:
+  bool mLocked;
+  uint32_t mBaseLocalMs;
+  uint64_t mBaseSharedMs;
+  int32_t mRatePpm;
+  uint32_t mAnchorLocalMs;
+  uint64_t mAnchorSharedMs;
+  uint64_t mLastNowMs;
+
+  uint64_t project(uint32_t localMs);
+  void step(uint32_t localMs, uint64_t sharedMs);
+
+public:
+  ClockSync();
+
+  void reset();
+
+  /**
+   * Feed a reference time taken at localMs
+   * @return true if the clock was stepped rather than slewed, eg on first lock
+   */
+  bool sample(uint32_t localMs, uint64_t sharedMs);
+
+  /* Shared time at localMs, never going backwards between steps. Local time until locked. */
+  uint64_t now(uint32_t localMs);
+
+  bool isLocked() { return mLocked; };
+  int32_t getRatePpm() { return mRatePpm; };
+
+  /* Most recent UTC midnight, in shared ms. Used as the default epoch so patterns line up. */
+  static uint64_t startOfDay(uint64_t sharedMs) { return sharedMs - (sharedMs % MS_PER_DAY); };
+};
+
+#endif
@@ -1,9 +1,14 @@
 #include "cloudFunctions.h"
 #include "argParser.h"
 #include "colours.h"
-#include "utils.h"
+
+using argParser::RET_VAL_SUC;
+using argParser::RET_VAL_TOO_MANY_ARGS;
+using argParser::RET_VAL_INVALID_ARG;
 
 #define NUM_LEDS_MAX 170
+#define TRANSITION_MS_DEFAULT 500
+#define TRANSITION_MS_MAX 60000
 
 #define ARG_COUNT_BLINK 4
 #define ARG_COUNT_COLOUR 1
@@ -13,6 +18,13 @@
 #define ARG_COUNT_PULSE 3
 #define ARG_COUNT_SNAKE 5
 #define ARG_COUNT_WEATHER 9
+#define ARG_COUNT_TRANSITION 1
+#define ARG_COUNT_PLAYLIST_ENTRY 2
+#define ARG_COUNT_SCHEDULE_ENTRY 2
+
+#define SCHEDULE_REPEAT_DAILY 1
+
+#define START_TIME_PREFIX "@"
 
 const argParser::ArgInfo ARG_INFO_PERIOD_MS = {
   .type = ARG_TYPE_NUMBER,
@@ -116,6 +128,36 @@ const argParser::ArgInfo ARG_INFO_WEATHER_WARNING_OFF_DWELL = {
   .max = 9999
 };
 
+const argParser::ArgInfo ARG_INFO_TRANSITION_MS = {
+  .type = ARG_TYPE_NUMBER,
+  .min = 0,
+  .max = TRANSITION_MS_MAX
+};
+
+const argParser::ArgInfo ARG_INFO_PLAYLIST_DURATION_MS = {
+  .type = ARG_TYPE_NUMBER,
+  .min = 1,
+  .max = 2147483647
+};
+
+const argParser::ArgInfo ARG_INFO_SCHEDULE_TIME = {
+  .type = ARG_TYPE_NUMBER,
+  .min = 0,
+  .max = 2147483647
+};
+
+const argParser::ArgInfo ARG_INFO_SCHEDULE_REPEAT = {
+  .type = ARG_TYPE_NUMBER,
+  .min = 0,
+  .max = SCHEDULE_REPEAT_DAILY
+};
+
+const argParser::ArgInfo ARG_INFO_START_TIME = {
+  .type = ARG_TYPE_NUMBER,
+  .min = 0,
+  .max = 2147483647
+};
+
 const argParser::ArgInfo ARG_INFO_COLOUR = {
   .type = ARG_TYPE_COLOUR
 };
@@ -178,6 +220,20 @@ const argParser::ArgInfo ARGS_INFO_COLOUR[] = {
   ARG_INFO_COLOUR
 };
 
+const argParser::ArgInfo ARGS_INFO_TRANSITION[] = {
+  ARG_INFO_TRANSITION_MS
+};
+
+const argParser::ArgInfo ARGS_INFO_PLAYLIST_ENTRY[] = {
+  ARG_INFO_PLAYLIST_DURATION_MS,
+  ARG_INFO_TRANSITION_MS
+};
+
+const argParser::ArgInfo ARGS_INFO_SCHEDULE_ENTRY[] = {
+  ARG_INFO_SCHEDULE_TIME,
+  ARG_INFO_SCHEDULE_REPEAT
+};
+
 const argParser::ArgConfig ARG_CONFIG_STROBE = {
   .info = ARGS_INFO_STROBE,
   .length = ARG_COUNT_STROBE,
@@ -218,16 +274,78 @@ const argParser::ArgConfig ARG_CONFIG_WEATHER = {
   .length = ARG_COUNT_WEATHER,
 };
 
+const argParser::ArgConfig ARG_CONFIG_TRANSITION = {
+  .info = ARGS_INFO_TRANSITION,
+  .length = ARG_COUNT_TRANSITION,
+};
+
+const argParser::ArgConfig ARG_CONFIG_PLAYLIST_ENTRY = {
+  .info = ARGS_INFO_PLAYLIST_ENTRY,
+  .length = ARG_COUNT_PLAYLIST_ENTRY,
+};
+
+const argParser::ArgConfig ARG_CONFIG_SCHEDULE_ENTRY = {
+  .info = ARGS_INFO_SCHEDULE_ENTRY,
+  .length = ARG_COUNT_SCHEDULE_ENTRY,
+};
+
+const argParser::ArgConfig ARG_CONFIG_START_TIME = {
+  .info = &ARG_INFO_START_TIME,
+  .length = 1,
+};
+
+//order must not change, playlists store the index of the command
+const CloudFunctions::CommandInfo CloudFunctions::COMMANDS[] = {
+  { "blink", &ARG_CONFIG_BLINK, &CloudFunctions::applyBlink },
+  { "colour", &ARG_CONFIG_COLOUR, &CloudFunctions::applyColour },
+  { "strobe", &ARG_CONFIG_STROBE, &CloudFunctions::applyStrobe },
+  { "gradient", &ARG_CONFIG_GRADIENT, &CloudFunctions::applyGradient },
+  { "progress", &ARG_CONFIG_PROGRESS, &CloudFunctions::applyProgress },
+  { "pulse", &ARG_CONFIG_PULSE, &CloudFunctions::applyPulse },
+  { "snake", &ARG_CONFIG_SNAKE, &CloudFunctions::applySnake },
+  { "weather", &ARG_CONFIG_WEATHER, &CloudFunctions::applyWeather },
+};
+
+const uint32_t CloudFunctions::COMMAND_COUNT = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+
 static Direction intToDirection(uint8_t value) {
   return value == 0 ? Direction::forward : Direction::reverse;
 }
 
-CloudFunctions::CloudFunctions(LedStripDriver *ledDriver, int (*regFn)(String, int (CloudFunctions::*cloudFn)(String), CloudFunctions*)) {
+//an optional last argument of '@<unix time>' gives the time the pattern started, 0 if not given
+static int32_t takeStartTime(String *args, uint32_t *startTime) {
+  int32_t index = args->lastIndexOf(',');
+  String field = args->substring(index + 1);
+
+  *startTime = 0;
+
+  if (!field.startsWith(START_TIME_PREFIX)) {
+    return RET_VAL_SUC;
+  }
+
+  *args = args->substring(0, index < 0 ? 0 : index);
+
+  return argParser::parseArgs(startTime, &ARG_CONFIG_START_TIME, field.substring(1));
+}
+
+//colour arguments are parsed as 0xRRGGBB
+static Colour* newColour(uint32_t value) {
+  return new Colour(Colour::fromPacked(value));
+}
+
+CloudFunctions::CloudFunctions(LedStripDriver *ledDriver, int (*regFn)(String, int (CloudFunctions::*cloudFn)(String), CloudFunctions*))
+  : mPlaylist(&mPlaylistStore) {
   mLedDriver = ledDriver;
   mColourOn = new COLOUR_BLACK;
   mColourOff = new COLOUR_BLACK;
   mWeatherRainColour = new COLOUR_WHITE;
   mWeatherWarningColour = new COLOUR_WHITE;
+  mPatternChangeFn = nullptr;
+  mPlaylistChangeFn = nullptr;
+  mScheduleChangeFn = nullptr;
+  mClockFn = nullptr;
+  mTransitionMs = TRANSITION_MS_DEFAULT;
+  mPlaylist.clear();
 
   regFn(String("blink"), (&CloudFunctions::blink), this);
   regFn(String("colour"), (&CloudFunctions::colour), this);
@@ -237,10 +355,16 @@ CloudFunctions::CloudFunctions(LedStripDriver *ledDriver, int (*regFn)(String, i
   regFn(String("pulse"), (&CloudFunctions::pulse), this);
   regFn(String("snake"), (&CloudFunctions::snake), this);
   regFn(String("weather"), (&CloudFunctions::weather), this);
+  regFn(String("transition"), (&CloudFunctions::transition), this);
+  regFn(String("playlist"), (&CloudFunctions::playlist), this);
+  regFn(String("schedule"), (&CloudFunctions::schedule), this);
 }
 
 CloudFunctions::~CloudFunctions() {
   deleteColours();
+
+  delete mWeatherRainColour;
+  delete mWeatherWarningColour;
 }
 
 void CloudFunctions::deleteColours() {
@@ -253,226 +377,449 @@ void CloudFunctions::deleteColours() {
     delete mColourOff;
     mColourOff = nullptr;
   }
+}
 
-  if (mWeatherRainColour != nullptr) {
-    delete mWeatherRainColour;
-    mWeatherRainColour = nullptr;
-  }
+CloudFunctions* CloudFunctions::onPatternChange(void (*fn)(uint32_t transitionMs, uint32_t startTime)) {
+  mPatternChangeFn = fn;
+  return this;
+}
+
+CloudFunctions* CloudFunctions::onPlaylistChange(void (*fn)(const playlist_store_t *store)) {
+  mPlaylistChangeFn = fn;
+  return this;
+}
 
-  if (mWeatherWarningColour != nullptr) {
-    delete mWeatherWarningColour;
-    mWeatherWarningColour = nullptr;
+CloudFunctions* CloudFunctions::onScheduleChange(void (*fn)(const schedule_store_t *store)) {
+  mScheduleChangeFn = fn;
+  return this;
+}
+
+CloudFunctions* CloudFunctions::wallClock(uint32_t (*nowFn)()) {
+  mClockFn = nowFn;
+  return this;
+}
+
+int32_t CloudFunctions::findCommand(String name) {
+  for (uint32_t i=0; i<COMMAND_COUNT; i++) {
+    if (name.equals(COMMANDS[i].name)) {
+      return i;
+    }
   }
+
+  return -1;
 }
 
-int CloudFunctions::blink(String args) {
-  String parsedArgs[ARG_COUNT_BLINK];
-  int32_t result = parseAndValidateArgs(parsedArgs, &ARG_CONFIG_BLINK, args);
-  uint32_t period;
-  uint32_t dutyCycle;
+void CloudFunctions::apply(uint32_t command,
+                           const uint32_t *values,
+                           uint32_t transitionMs,
+                           uint32_t startTime) {
+  deleteColours();
 
-  if (result == 0) {
-    deleteColours();
+  (this->*COMMANDS[command].apply)(values);
 
-    mColourOn = new Colour(parsedArgs[2]);
-    mColourOff = new Colour(parsedArgs[3]);
+  if (mPatternChangeFn != nullptr) {
+    mPatternChangeFn(transitionMs, startTime);
+  }
+}
+
+int CloudFunctions::run(uint32_t command, String args) {
+  uint32_t values[argParser::ARG_COUNT_MAX];
+  uint32_t startTime;
+  int32_t result = takeStartTime(&args, &startTime);
 
-    strToInt(&period, parsedArgs[0]);
-    strToInt(&dutyCycle, parsedArgs[1]);
+  if (result == RET_VAL_SUC) {
+    result = argParser::parseArgs(values, COMMANDS[command].config, args);
+  }
 
-    mLedDriver->pattern(Pattern::blink)
-      ->period(period)
-      ->dutyCycle((uint8_t)dutyCycle)
-      ->colourOn(mColourOn)
-      ->colourOff(mColourOff);
+  if (result == RET_VAL_SUC) {
+    WITH_LOCK(mLock) {
+      setPattern(command, values, startTime);
+    }
   }
 
   return result;
 }
 
-int CloudFunctions::colour(String args) {
-  String parsedArgs[ARG_COUNT_COLOUR];
-  int32_t result = parseAndValidateArgs(parsedArgs, &ARG_CONFIG_COLOUR, args);
+//a pattern set directly or by the schedule overrides the playlist
+void CloudFunctions::setPattern(uint32_t command, const uint32_t *values, uint32_t startTime) {
+  mPlaylist.stop();
+  apply(command, values, mTransitionMs, startTime);
+}
 
-  if (result == 0) {
-    deleteColours();
+void CloudFunctions::applyBlink(const uint32_t *values) {
+  mColourOn = newColour(values[2]);
+  mColourOff = newColour(values[3]);
 
-    mColourOn = new Colour(parsedArgs[0]);
-    mColourOff = nullptr;
+  mLedDriver->pattern(Pattern::blink)
+    ->period(values[0])
+    ->dutyCycle((uint8_t)values[1])
+    ->colourOn(mColourOn)
+    ->colourOff(mColourOff);
+}
 
-    mLedDriver->pattern(Pattern::colour)
-      ->colourOn(mColourOn);
-  }
+void CloudFunctions::applyColour(const uint32_t *values) {
+  mColourOn = newColour(values[0]);
+  mColourOff = new COLOUR_BLACK;
 
-  return result;
+  mLedDriver->pattern(Pattern::colour)
+    ->colourOn(mColourOn)
+    ->colourOff(mColourOff);
+}
+
+void CloudFunctions::applyStrobe(const uint32_t *values) {
+  mColourOn = newColour(values[1]);
+  mColourOff = new COLOUR_BLACK;
+
+  mLedDriver->pattern(Pattern::strobe)
+    ->period(values[0])
+    ->colourOn(mColourOn)
+    ->colourOff(mColourOff);
+}
+
+void CloudFunctions::applyGradient(const uint32_t *values) {
+  mColourOn = newColour(values[0]);
+  mColourOff = newColour(values[1]);
+
+  mLedDriver->pattern(Pattern::gradient)
+    ->colourOff(mColourOff)
+    ->colourOn(mColourOn);
+}
+
+void CloudFunctions::applyProgress(const uint32_t *values) {
+  mColourOn = newColour(values[6]);
+  mColourOff = newColour(values[7]);
+
+  mLedDriver->pattern(Pattern::progress)
+    ->initialValue((uint8_t)values[0])
+    ->finalValue((uint8_t)values[1])
+    ->increment((uint8_t)values[2])
+    ->incDelay(values[3])
+    ->resetDelay(values[4])
+    ->progressDirection(intToDirection(values[5]))
+    ->colourOn(mColourOn)
+    ->colourOff(mColourOff);
+}
+
+void CloudFunctions::applyPulse(const uint32_t *values) {
+  mColourOn = newColour(values[1]);
+  mColourOff = newColour(values[2]);
+
+  mLedDriver->pattern(Pattern::pulse)
+    ->period(values[0])
+    ->colourOn(mColourOn)
+    ->colourOff(mColourOff);
+}
+
+void CloudFunctions::applySnake(const uint32_t *values) {
+  mColourOn = newColour(values[3]);
+  mColourOff = newColour(values[4]);
+
+  mLedDriver->pattern(Pattern::snake)
+    ->period(values[0])
+    ->length(values[2])
+    ->snakeDirection(intToDirection(values[1]))
+    ->colourOn(mColourOn)
+    ->colourOff(mColourOff);
+}
+
+void CloudFunctions::applyWeather(const uint32_t *values) {
+  mColourOn = newColour(values[0]);
+  mColourOff = newColour(values[1]);
+
+  mLedDriver->pattern(Pattern::weather)
+    ->colourOn(mColourOn)
+    ->colourOff(mColourOff)
+    ->tempFadeInterval(values[2])
+    ->rainBandHeight(values[3])
+    ->rainBandIncrementDelay(values[4])
+    ->rainBandSpacing(values[5])
+    ->rainBandColour(mWeatherRainColour)
+    ->rainDirection(Direction::reverse)
+    ->warningColour(mWeatherWarningColour)
+    ->warningFadeIn(values[6])
+    ->warningFadeOut(values[7])
+    ->warningOffDwell(values[8]);
+}
+
+int CloudFunctions::blink(String args) {
+  return run(COMMAND_BLINK, args);
+}
+
+int CloudFunctions::colour(String args) {
+  return run(COMMAND_COLOUR, args);
 }
 
 int CloudFunctions::strobe(String args) {
-  String parsedArgs[ARG_COUNT_STROBE];
-  int32_t result = parseAndValidateArgs(parsedArgs, &ARG_CONFIG_STROBE, args);
-  uint32_t period;
+  return run(COMMAND_STROBE, args);
+}
 
-  if (result == 0) {
-    deleteColours();
+int CloudFunctions::gradient(String args) {
+  return run(COMMAND_GRADIENT, args);
+}
 
-    mColourOn = new Colour(parsedArgs[1]);
-    mColourOff = new COLOUR_BLACK;
+int CloudFunctions::progress(String args) {
+  return run(COMMAND_PROGRESS, args);
+}
 
-    strToInt(&period, parsedArgs[0]);
+int CloudFunctions::pulse(String args) {
+  return run(COMMAND_PULSE, args);
+}
+
+int CloudFunctions::snake(String args) {
+  return run(COMMAND_SNAKE, args);
+}
 
-    mLedDriver->pattern(Pattern::strobe)
-      ->period(period)
-      ->colourOn(mColourOn)
-      ->colourOff(mColourOff);
+int CloudFunctions::weather(String args) {
+  return run(COMMAND_WEATHER, args);
+}
+
+int CloudFunctions::transition(String args) {
+  uint32_t values[ARG_COUNT_TRANSITION];
+  int32_t result = argParser::parseArgs(values, &ARG_CONFIG_TRANSITION, args);
+
+  //read by the render thread as it applies playlist and scheduled patterns
+  if (result == RET_VAL_SUC) {
+    WITH_LOCK(mLock) {
+      mTransitionMs = values[0];
+    }
   }
 
   return result;
 }
 
-int CloudFunctions::gradient(String args) {
-  String parsedArgs[ARG_COUNT_GRADIENT];
-  int32_t result = parseAndValidateArgs(parsedArgs, &ARG_CONFIG_GRADIENT, args);
+/**
+ * Parse an entry made of a pattern name, its own header arguments and the pattern's arguments
+ * @param entry '<pattern>,<header args>,<pattern args>'
+ * @return RET_VAL_SUC on success, error code on failure
+ */
+int32_t CloudFunctions::parseEntry(String entry,
+                                   const argParser::ArgConfig *headerConfig,
+                                   uint32_t *header,
+                                   uint32_t *command,
+                                   uint32_t *values) {
+  const char delimiter = ',';
+  int32_t pos = entry.indexOf(delimiter);
+  int32_t argsPos = pos;
+  int32_t index;
+  int32_t result;
+
+  //pattern arguments start after the header arguments
+  for (uint32_t i=0; i < headerConfig->length && argsPos >= 0; i++) {
+    argsPos = entry.indexOf(delimiter, argsPos + 1);
+  }
 
-  if (result == 0) {
-    deleteColours();
+  if (argsPos < 0) {
+    return argParser::RET_VAL_TOO_FEW_ARGS;
+  }
 
-    mColourOn = new Colour(parsedArgs[0]);
-    mColourOff = new Colour(parsedArgs[1]);
+  index = findCommand(entry.substring(0, pos));
 
-    mLedDriver->pattern(Pattern::gradient)
-      ->colourOff(mColourOff)
-      ->colourOn(mColourOn);
+  if (index < 0) {
+    return RET_VAL_INVALID_ARG;
   }
 
-  return result;
+  result = argParser::parseArgs(header, headerConfig, entry.substring(pos + 1, argsPos));
+
+  if (result != RET_VAL_SUC) {
+    return result;
+  }
+
+  *command = index;
+
+  return argParser::parseArgs(values, COMMANDS[index].config, entry.substring(argsPos + 1));
 }
 
-int CloudFunctions::progress(String args) {
-  String parsedArgs[ARG_COUNT_PROGRESS];
-  int32_t result = parseAndValidateArgs(parsedArgs, &ARG_CONFIG_PROGRESS, args);
-  uint32_t initialValue;
-  uint32_t finalValue;
-  uint32_t increment;
-  uint32_t incDelay;
-  uint32_t resetDelay;
-  uint32_t direction;
-
-  if (result == 0) {
-    deleteColours();
-
-    strToInt(&initialValue, parsedArgs[0]);
-    strToInt(&finalValue, parsedArgs[1]);
-    strToInt(&increment, parsedArgs[2]);
-    strToInt(&incDelay, parsedArgs[3]);
-    strToInt(&resetDelay, parsedArgs[4]);
-    strToInt(&direction, parsedArgs[5]);
-
-    mColourOn = new Colour(parsedArgs[6]);
-    mColourOff = new Colour(parsedArgs[7]);
-
-    mLedDriver->pattern(Pattern::progress)
-      ->initialValue((uint8_t)initialValue)
-      ->finalValue((uint8_t)finalValue)
-      ->increment((uint8_t)increment)
-      ->incDelay(incDelay)
-      ->resetDelay(resetDelay)
-      ->progressDirection(intToDirection(direction))
-      ->colourOn(mColourOn)
-      ->colourOff(mColourOff);
+/**
+ * Parse one playlist entry
+ * @param entry '<pattern>,<duration (ms)>,<transition (ms)>,<pattern args>'
+ * @return RET_VAL_SUC on success, error code on failure
+ */
+int32_t CloudFunctions::addPlaylistEntry(String entry) {
+  uint32_t header[ARG_COUNT_PLAYLIST_ENTRY];
+  uint32_t values[argParser::ARG_COUNT_MAX];
+  uint32_t command;
+  int32_t result = parseEntry(entry, &ARG_CONFIG_PLAYLIST_ENTRY, header, &command, values);
+
+  if (result != RET_VAL_SUC) {
+    return result;
   }
 
-  return result;
+  if (!mPlaylist.add(command, COMMANDS[command].config, values, header[0], header[1])) {
+    return RET_VAL_TOO_MANY_ARGS;
+  }
+
+  return RET_VAL_SUC;
 }
 
-int CloudFunctions::pulse(String args) {
-  String parsedArgs[ARG_COUNT_PULSE];
-  int32_t result = parseAndValidateArgs(parsedArgs, &ARG_CONFIG_PULSE, args);
-  uint32_t period;
+int CloudFunctions::playlist(String args) {
+  const char delimiter = ';';
+  int32_t start = 0;
+  int32_t result = RET_VAL_SUC;
+  playlist_store_t saved;
+
+  WITH_LOCK(mLock) {
+    mPlaylist.clear();
+
+    while (args.length() > 0 && result == RET_VAL_SUC) {
+      int32_t end = args.indexOf(delimiter, start);
 
-  if (result == 0) {
-    deleteColours();
+      result = addPlaylistEntry(args.substring(start, end < 0 ? args.length() : end));
 
-    strToInt(&period, parsedArgs[0]);
+      if (end < 0) {
+        break;
+      }
 
-    mColourOn = new Colour(parsedArgs[1]);
-    mColourOff = new Colour(parsedArgs[2]);
+      start = end + 1;
+    }
 
-    mLedDriver->pattern(Pattern::pulse)
-      ->period(period)
-      ->colourOn(mColourOn)
-      ->colourOff(mColourOff);
+    if (result == RET_VAL_SUC) {
+      saved = mPlaylistStore;
+      mPlaylist.start();
+    } else {
+      mPlaylist.clear();
+    }
   }
 
-  return result;
+  if (result != RET_VAL_SUC) {
+    return result;
+  }
+
+  //persisted from a copy so the render thread isn't held up by the write
+  if (mPlaylistChangeFn != nullptr) {
+    mPlaylistChangeFn(&saved);
+  }
+
+  return RET_VAL_SUC;
 }
 
-int CloudFunctions::snake(String args) {
-  String parsedArgs[ARG_COUNT_SNAKE];
-  int32_t result = parseAndValidateArgs(parsedArgs, &ARG_CONFIG_SNAKE, args);
-  uint32_t period;
-  uint32_t direction;
-  uint32_t length;
-
-  if (result == 0) {
-    deleteColours();
-
-    strToInt(&period, parsedArgs[0]);
-    strToInt(&direction, parsedArgs[1]);
-    strToInt(&length, parsedArgs[2]);
-
-    mColourOn = new Colour(parsedArgs[3]);
-    mColourOff = new Colour(parsedArgs[4]);
-
-    mLedDriver->pattern(Pattern::snake)
-      ->period(period)
-      ->length(length)
-      ->snakeDirection(intToDirection(direction))
-      ->colourOn(mColourOn)
-      ->colourOff(mColourOff);
+bool CloudFunctions::loadPlaylist(const playlist_store_t *store) {
+  bool valid;
+
+  WITH_LOCK(mLock) {
+    mPlaylistStore = *store;
+    valid = mPlaylist.isValid();
+
+    for (uint32_t i=0; valid && i<mPlaylist.length(); i++) {
+      playlist_entry_t entry;
+      mPlaylist.entry(i, &entry);
+
+      //a corrupt store could otherwise unpack arguments past the end of the pool
+      valid = entry.command < COMMAND_COUNT && mPlaylist.entryFits(i, COMMANDS[entry.command].config);
+    }
+
+    if (valid) {
+      mPlaylist.start();
+    } else {
+      mPlaylist.clear();
+    }
   }
 
-  return result;
+  return valid;
 }
 
-int CloudFunctions::weather(String args) {
-  String parsedArgs[ARG_COUNT_WEATHER];
-  int32_t result = parseAndValidateArgs(parsedArgs, &ARG_CONFIG_WEATHER, args);
-  uint32_t tempFadeSecs;
-  uint32_t bandDepth;
-  uint32_t bandSpeed;
-  uint32_t bandSpacing;
-  uint32_t warningFadeInMs;
-  uint32_t warningFadeOutMs;
-  uint32_t warningOffDwellMs;
-
-  if (result == 0) {
-    deleteColours();
-
-    mColourOn = new Colour(parsedArgs[0]);
-    mColourOff = new Colour(parsedArgs[1]);
-
-    strToInt(&tempFadeSecs, parsedArgs[2]);
-    strToInt(&bandDepth, parsedArgs[3]);
-    strToInt(&bandSpeed, parsedArgs[4]);
-    strToInt(&bandSpacing, parsedArgs[5]);
-    strToInt(&warningFadeInMs, parsedArgs[6]);
-    strToInt(&warningFadeOutMs, parsedArgs[7]);
-    strToInt(&warningOffDwellMs, parsedArgs[8]);
-
-    mLedDriver->pattern(Pattern::weather)
-      ->colourOn(mColourOn)
-      ->colourOff(mColourOff)
-      ->tempFadeInterval(tempFadeSecs)
-      ->rainBandHeight(bandDepth)
-      ->rainBandIncrementDelay(bandSpeed)
-      ->rainBandSpacing(bandSpacing)
-      ->rainBandColour(mWeatherRainColour)
-      ->rainDirection(Direction::reverse)
-      ->warningColour(mWeatherWarningColour)
-      ->warningFadeIn(warningFadeInMs)
-      ->warningFadeOut(warningFadeOutMs)
-      ->warningOffDwell(warningOffDwellMs);
+bool CloudFunctions::loadSchedule(const schedule_store_t *store) {
+  bool valid = store->count <= SCHEDULE_ENTRIES_MAX;
+
+  for (uint32_t i=0; valid && i<store->count; i++) {
+    valid = store->entries[i].command < COMMAND_COUNT;
+  }
+
+  WITH_LOCK(mLock) {
+    if (valid) {
+      valid = mScheduler.load(store);
+    } else {
+      mScheduler.clear();
+    }
+  }
+
+  return valid;
+}
+
+void CloudFunctions::scheduleChanged() {
+  if (mScheduleChangeFn != nullptr) {
+    mScheduleChangeFn(mScheduler.store());
+  }
+}
+
+int CloudFunctions::schedule(String args) {
+  uint32_t header[ARG_COUNT_SCHEDULE_ENTRY];
+  uint32_t values[argParser::ARG_COUNT_MAX];
+  uint32_t command;
+  uint32_t time;
+  int32_t result;
+
+  if (args.length() == 0) {
+    WITH_LOCK(mLock) {
+      mScheduler.clear();
+      scheduleChanged();
+    }
+
+    return RET_VAL_SUC;
+  }
+
+  if (mClockFn == nullptr) {
+    return RET_VAL_INVALID_ARG;
+  }
+
+  result = parseEntry(args, &ARG_CONFIG_SCHEDULE_ENTRY, header, &command, values);
+
+  if (result != RET_VAL_SUC) {
+    return result;
+  }
+
+  if (header[1] == SCHEDULE_REPEAT_DAILY) {
+    const uint32_t now = mClockFn();
+
+    //the first time is worked out from today's date, which isn't known until the clock is set
+    if (header[0] >= SECONDS_PER_DAY || now == 0) {
+      return RET_VAL_INVALID_ARG;
+    }
+
+    time = Scheduler::nextDailyTime(now, header[0]);
+  } else {
+    time = header[0];
+  }
+
+  WITH_LOCK(mLock) {
+    if (mScheduler.add(command,
+                       COMMANDS[command].config,
+                       values,
+                       time,
+                       header[1] == SCHEDULE_REPEAT_DAILY ? SECONDS_PER_DAY : 0)) {
+      scheduleChanged();
+    } else {
+      result = RET_VAL_TOO_MANY_ARGS;
+    }
   }
 
   return result;
 }
+
+void CloudFunctions::onTick(uint32_t elapsedMs) {
+  uint32_t values[argParser::ARG_COUNT_MAX];
+  schedule_entry_t scheduled;
+
+  WITH_LOCK(mLock) {
+    int32_t index = mPlaylist.tick(elapsedMs);
+
+    if (index >= 0) {
+      playlist_entry_t entry;
+
+      mPlaylist.entry(index, &entry);
+      argParser::unpackArgs(values, COMMANDS[entry.command].config, entry.args);
+
+      apply(entry.command, values, entry.transitionMs, 0);
+    }
+
+    //only the earliest entry is checked, any others due fire on the following ticks.  The pattern
+    //starts from its scheduled time so units sharing a schedule run in phase
+    if (mClockFn != nullptr && mScheduler.next(mClockFn(), &scheduled)) {
+      argParser::unpackArgs(values, COMMANDS[scheduled.command].config, scheduled.args);
+
+      setPattern(scheduled.command, values, scheduled.time);
+
+      //a fired entry is dropped or moved on to its next time, keep the saved copy in step
+      scheduleChanged();
+    }
+  }
+}
@@ -2,23 +2,112 @@
 #define OBELISK_CLOUD_FUNCTIONS_H
 
 #include "Particle.h"
+#include "argParser.h"
 #include "colour.h"
 #include "ledStripDriver.h"
+#include "playlist.h"
+#include "scheduler.h"
+
+enum Command {
+  COMMAND_BLINK,
+  COMMAND_COLOUR,
+  COMMAND_STROBE,
+  COMMAND_GRADIENT,
+  COMMAND_PROGRESS,
+  COMMAND_PULSE,
+  COMMAND_SNAKE,
+  COMMAND_WEATHER,
+};
 
 class CloudFunctions {
   private:
+  typedef void (CloudFunctions::*ApplyFn)(const uint32_t *values);
+
+  typedef struct {
+    const char *name;
+    const argParser::ArgConfig *config;
+    ApplyFn apply;
+  } CommandInfo;
+
+  static const CommandInfo COMMANDS[];
+  static const uint32_t COMMAND_COUNT;
+
   LedStripDriver *mLedDriver;
   Colour *mColourOn;
   Colour *mColourOff;
   Colour *mWeatherRainColour;
   Colour *mWeatherWarningColour;
 
+  void (*mPatternChangeFn)(uint32_t transitionMs, uint32_t startTime);
+  void (*mPlaylistChangeFn)(const playlist_store_t *store);
+  void (*mScheduleChangeFn)(const schedule_store_t *store);
+  uint32_t (*mClockFn)();
+  uint32_t mTransitionMs;
+
+  //commands arrive on the cloud and USB threads while the playlist and schedule tick on the
+  //render thread, this keeps the colours, playlist and schedule to one at a time
+  RecursiveMutex mLock;
+  playlist_store_t mPlaylistStore;
+  Playlist mPlaylist;
+  Scheduler mScheduler;
+
   void deleteColours();
+  int run(uint32_t command, String args);
+  void setPattern(uint32_t command, const uint32_t *values, uint32_t startTime);
+  int32_t parseEntry(String entry,
+                     const argParser::ArgConfig *headerConfig,
+                     uint32_t *header,
+                     uint32_t *command,
+                     uint32_t *values);
+  int32_t addPlaylistEntry(String entry);
+  void scheduleChanged();
+
+  void applyBlink(const uint32_t *values);
+  void applyColour(const uint32_t *values);
+  void applyStrobe(const uint32_t *values);
+  void applyGradient(const uint32_t *values);
+  void applyProgress(const uint32_t *values);
+  void applyPulse(const uint32_t *values);
+  void applySnake(const uint32_t *values);
+  void applyWeather(const uint32_t *values);
 
   public:
   CloudFunctions(LedStripDriver *ledDriver, int (*regFn)(String, int (CloudFunctions::*cloudFn)(String), CloudFunctions*));
   ~CloudFunctions();
 
+  /*
+   * Called once the driver is reconfigured, with the crossfade duration to use and the unix
+   * time the pattern started at (0 = now)
+   */
+  CloudFunctions* onPatternChange(void (*fn)(uint32_t transitionMs, uint32_t startTime));
+
+  /* Called when a new playlist is uploaded so it can be persisted */
+  CloudFunctions* onPlaylistChange(void (*fn)(const playlist_store_t *store));
+
+  /*
+   * Called when the schedule changes so it can be persisted, including when an entry fires on the
+   * render thread, so it should only take a copy
+   */
+  CloudFunctions* onScheduleChange(void (*fn)(const schedule_store_t *store));
+
+  /* Source of unix time for the schedule, returning 0 while the time is unknown */
+  CloudFunctions* wallClock(uint32_t (*nowFn)());
+
+  /* Index of the named command, or -1 if there isn't one */
+  int32_t findCommand(String name);
+
+  /* Configure the driver from values parsed with the command's argument schema */
+  void apply(uint32_t command, const uint32_t *values, uint32_t transitionMs, uint32_t startTime);
+
+  /* Restore a playlist saved by onPlaylistChange and start playing it */
+  bool loadPlaylist(const playlist_store_t *store);
+
+  /* Restore a schedule saved by onScheduleChange, its entries fire once the clock is known */
+  bool loadSchedule(const schedule_store_t *store);
+
+  /* Called on every render tick to advance the playlist and fire scheduled commands */
+  void onTick(uint32_t elapsedMs);
+
   int blink(String args);
   int colour(String args);
   int strobe(String args);
@@ -27,6 +116,9 @@ class CloudFunctions {
   int pulse(String args);
   int snake(String args);
   int weather(String args);
+  int transition(String args);
+  int playlist(String args);
+  int schedule(String args);
 };
 
 
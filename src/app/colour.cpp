@@ -2,66 +2,30 @@
 #include "utils.h"
 
 #define STR_LEN 7
-
-uint8_t hexColourStrValToInt(String hexStr) {
-  return (uint8_t) hexStrToInt(hexStr);
-}
-
-Colour::Colour(uint8_t red, uint8_t green, uint8_t blue) {
-  mRed = red;
-  mGreen = green;
-  mBlue = blue;
-  mIsValid = true;
-};
+#define HEX_DIGITS 6
 
 //value = '#rrggbb'
-Colour::Colour(String value) {
-  if (value.charAt(0) != '#' || value.length() != STR_LEN) {
-    mIsValid = false;
-  } else {
-    const String &redStr = value.substring(1,3);
-    const String &greenStr = value.substring(3,5);
-    const String &blueStr = value.substring(5,7);
+bool Colour::parse(const char *value, Colour *colour) {
+  uint32_t rgb;
 
-    mRed = hexColourStrValToInt(redStr);
-    mGreen = hexColourStrValToInt(greenStr);
-    mBlue = hexColourStrValToInt(blueStr);
-    mIsValid = true;
+  //the digits stop at the first non hex character so a short string never reads past its end
+  if (value[0] != '#' || hexDigitsToInt(&rgb, &value[1], HEX_DIGITS) != 0 || value[STR_LEN] != '\0') {
+    return false;
   }
-};
-
-uint8_t Colour::getRed() const {
-  return mRed;
-}
 
-uint8_t Colour::getGreen() const {
-  return mGreen;
-}
-
-uint8_t Colour::getBlue() const {
-  return mBlue;
-}
-
-bool Colour::isValid() {
-  return mIsValid;
-}
+  *colour = Colour::fromPacked(rgb);
 
-bool operator==(const Colour& lhs, const Colour& rhs) {
-  return (
-    lhs.getRed() == rhs.getRed() &&
-    lhs.getGreen() == rhs.getGreen() &&
-    lhs.getBlue() == rhs.getBlue()
-  );
+  return true;
 }
 
-bool operator!=(const Colour& lhs, const Colour& rhs) {
-  return !(lhs == rhs);
+bool Colour::parse(const String& value, Colour *colour) {
+  return parse(value.c_str(), colour);
 }
 
-String Colour::toString() {
+String Colour::toString() const {
   char str[STR_LEN+1];
 
-  sprintf(str, "#%02X%02X%02X", mRed, mGreen, mBlue);
+  sprintf(str, "#%02X%02X%02X", getRed(), getGreen(), getBlue());
 
   return String(str);
 }
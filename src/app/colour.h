@@ -3,22 +3,46 @@
 
 #include "Particle.h"
 
+/*
+ * An RGB(W) colour packed into 32 bits as 0xWWRRGGBB. Construction and the
+ * accessors are constexpr so named colours are compile time constants and pixel
+ * writes compile down to shifts.
+ */
 class Colour {
-  uint8_t mRed, mGreen, mBlue;
-  bool mIsValid;
+  uint32_t mValue;
 
 public:
-  Colour(uint8_t, uint8_t, uint8_t);
-  Colour(String);
-  uint8_t getRed() const;
-  uint8_t getGreen() const;
-  uint8_t getBlue() const;
-  bool isValid();
-
-  String toString();
+  constexpr Colour() : mValue(0) {}
+  constexpr Colour(uint8_t red, uint8_t green, uint8_t blue, uint8_t white = 0)
+    : mValue(((uint32_t)white << 24) | ((uint32_t)red << 16) | ((uint32_t)green << 8) | blue) {}
+
+  /* Colour from a packed 0xWWRRGGBB value, as produced by packed() and argParser */
+  static constexpr Colour fromPacked(uint32_t value) {
+    return Colour((uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value, (uint8_t)(value >> 24));
+  }
+
+  /*
+   * Parse '#rrggbb' into colour. Returns false and leaves colour untouched if
+   * value isn't a valid colour string.
+   */
+  static bool parse(const char *value, Colour *colour);
+  static bool parse(const String& value, Colour *colour);
+
+  constexpr uint8_t getRed() const { return (uint8_t)(mValue >> 16); }
+  constexpr uint8_t getGreen() const { return (uint8_t)(mValue >> 8); }
+  constexpr uint8_t getBlue() const { return (uint8_t)mValue; }
+  constexpr uint8_t getWhite() const { return (uint8_t)(mValue >> 24); }
+  constexpr uint32_t packed() const { return mValue; }
+
+  String toString() const;
 };
 
-bool operator==(const Colour& lhs, const Colour& rhs);
-bool operator!=(const Colour& lhs, const Colour& rhs);
+constexpr bool operator==(const Colour& lhs, const Colour& rhs) {
+  return lhs.packed() == rhs.packed();
+}
+
+constexpr bool operator!=(const Colour& lhs, const Colour& rhs) {
+  return !(lhs == rhs);
+}
 
 #endif
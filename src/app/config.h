@@ -9,8 +9,120 @@
 #define COLOURS_PER_LED 3
 #define PWM_DUTY_STEPS 10
 
-/* #define COLOUR_ORDER_RRGGBB */
-#define COLOUR_ORDER_GGRRBB
+/* Patterns render each LED as RGB, the output's channel order is applied as values are sent */
+#define INDEX_RED 0
+#define INDEX_GREEN 1
+#define INDEX_BLUE 2
+
+/**********************************
+ * Pixel layout
+ *********************************/
+#define PIXEL_MAP_OFFSET 0
+#define PIXEL_MAP_REVERSE false
+#define PIXEL_MAP_SERPENTINE_WIDTH 0
+#define PIXEL_MAP_MIRROR false
+#define PIXEL_MAP_REPEAT 0
+/* see ColourOrder, for pixel strip outputs (APA102 is usually orderBgr), DMX fixtures take theirs from DMX_FIXTURE_PROFILE */
+#define PIXEL_MAP_COLOUR_ORDER orderGrb
+
+/**********************************
+ * LED output
+ *********************************/
+/* see LedOutput, outputDmx for DMX fixtures, outputWs2812 or outputApa102 for a strip on the SPI port */
+#define LED_OUTPUT outputDmx
+/* 0 for SPI (A3/A5) or 1 for SPI1 (D4/D2) for pixel strips, DMX input shares DMA2 stream 2 with SPI so needs 1 */
+#define LED_SPI_PORT 0
+#define LED_SPI (LED_SPI_PORT == 1 ? SPI1 : SPI)
+/*
+ * SPI bits per LED bit, 4 at 3.75MHz meets the WS2812 datasheet timing with the Electron's SPI
+ * dividers. 3 bits runs at the next divider down, 1.875MHz, a long 1 pulse most strips tolerate
+ * for 25% less SPI data.
+ */
+#define WS2812_SPI_BITS 4
+#define WS2812_SPI_CLOCK_HZ (WS2812_SPI_BITS == 4 ? 3750000 : 1875000)
+/* low time that latches a frame, newer WS2812B parts need 280us */
+#define WS2812_RESET_US 300
+#define APA102_SPI_CLOCK_HZ 7500000
+/* master brightness, each LED's 5 bit brightness is worked out from it and the LED's colour */
+#define APA102_BRIGHTNESS 255
+
+/**********************************
+ * DMX fixtures
+ *********************************/
+/* slot layout of each pixel, see fixture.h */
+#define DMX_FIXTURE_PROFILE fixture::PROFILE_GRB
+/* DMX address of the first pixel less 1, frames are sent up to the last pixel's slots */
+#define DMX_START_SLOT 0
+/* frames are padded with 0s to this many slots, 24 keeps receivers that expect longer frames happy */
+#define DMX_FRAME_SLOTS_MIN 24
+/* the DMX512-A minimum break to break time, short frames are held at mark until it's up */
+#define DMX_BREAK_TO_BREAK_MIN_US 1204
+
+/**********************************
+ * DMX input
+ *********************************/
+/* show a universe from a console on the DMX port rather than the pattern, needs a pixel strip output */
+#define DMX_INPUT_ENABLED false
+/* slot of the first LED's red in the universe, from 0, for network input too */
+#define DMX_INPUT_START_SLOT 0
+/* back to the pattern when no frames arrive for this long */
+#define DMX_INPUT_TIMEOUT_MS 1000
+/* how the console's values combine with the pattern by range of LED values, see MergeMode, the rest show the pattern */
+#define DMX_MERGE_RANGES { \
+  { .first = 0, .count = NUM_LEDS * COLOURS_PER_LED, .mode = mergeInput }, \
+}
+
+/**********************************
+ * Network input
+ *********************************/
+/* see StreamProtocol, universes streamed over UDP are merged like DMX input and take priority over it */
+#define STREAM_PROTOCOL streamOff
+/* sACN universe (1-63999) or Art-Net port address (0-32767), send unicast as cellular doesn't carry multicast */
+#define STREAM_UNIVERSE 1
+/* the sACN data loss timeout */
+#define STREAM_TIMEOUT_MS 2500
+
+/**********************************
+ * USB serial link
+ *********************************/
+/* frames and commands from a PC over USB serial, see SerialLink, frames take priority over other input */
+#define SERIAL_LINK_ENABLED false
+#define SERIAL_LINK_TIMEOUT_MS 1000
+
+/**********************************
+ * Frame timing
+ *********************************/
+/* render thread wakes at the greatest common period of the strip and status LED */
+#define RENDER_THREAD_PERIOD_MS TIMER_RESOLUTION_MS
+#define RENDER_THREAD_PRIORITY (OS_THREAD_PRIORITY_DEFAULT + 2)
+#define RENDER_THREAD_STACK_SIZE 3072
+/* see OverrunPolicy */
+#define FRAME_OVERRUN_POLICY overrunSkip
+#define FRAME_INTERVAL_MAX_MS 200
+#define FRAME_RECOVER_FRAMES 400
+#define FRAME_MISSED_RENDER_MAX 4
+/* longest gap between frames while a pattern isn't changing, fixtures blank after ~1s without data */
+#define DMX_KEEPALIVE_MS 800
+#define TELEMETRY_INTERVAL_MS 10000
+
+/**********************************
+ * Phase sync
+ *********************************/
+/* Start patterns from the shared clock's midnight unless given a start time, so all units line up */
+#define PHASE_SYNC_ENABLED false
+#define TIME_SYNC_INTERVAL_MS (60 * 60 * 1000)
+
+/**********************************
+ * Profiling
+ *********************************/
+/* #define RENDER_PROFILING */
+#define PROFILE_REPORT_INTERVAL_MS 10000
+
+/**********************************
+ * EEPROM layout
+ *********************************/
+#define EEPROM_ADDR_PLAYLIST 0
+#define EEPROM_ADDR_SCHEDULE 512
 
 /**********************************
  * Status LED
@@ -23,18 +135,4 @@
 #define STATUS_SLOW_FLASH_PERIOD_MS 2000
 #define STATUS_BLINK_PERIOD_MS 3000
 
-/*********************************************************************************
- *  Calculated values
- ********************************************************************************/
-
-#ifdef COLOUR_ORDER_GGRRBB
-  #define INDEX_GREEN 0
-  #define INDEX_RED 1
-  #define INDEX_BLUE 2
-#else
-  #define INDEX_RED 0
-  #define INDEX_GREEN 1
-  #define INDEX_BLUE 2
-#endif
-
 #endif
@@ -1,6 +1,8 @@
 #include "dmx.h"
+#include "config.h"
 #include "stm32f2xx_usart.h"
 #include "stm32f2xx_rcc.h"
+#include "stm32f2xx_dma.h"
 
 #define PIN_DRV_EN B0
 #define PIN_RCV_EN B2
@@ -12,8 +14,20 @@ static const uint8_t CHAR_BREAK = 0;
 static const uint8_t START_CODE_NULL = 0;
 static const uint32_t BAUD_BREAK = 80000;
 static const uint32_t BAUD_DMX = 250000;
+/* the break character's two stop bits, the line goes high for the mark after break */
+static const uint32_t BREAK_STOP_US = 2 * 1000000 / BAUD_BREAK;
+
+//USART1 RX requests are on DMA2 stream 2 channel 4
+#define RX_DMA_STREAM DMA2_Stream2
+#define RX_DMA_CHANNEL DMA_Channel_4
+#define RX_DMA_FLAGS (DMA_FLAG_TCIF2 | DMA_FLAG_HTIF2 | DMA_FLAG_TEIF2 | DMA_FLAG_DMEIF2 | DMA_FLAG_FEIF2)
 
 namespace dmx {
+  static DmxReceiver frameReceiver(DMX_INPUT_TIMEOUT_MS);
+  static DmxTxStats txStats(BREAK_STOP_US);
+  static const dmx_frame_config_t *frameConfig;
+  static uint32_t lastBreakUs;
+
   void receiverControl(bool enable);
   void driverControl(bool enable);
 
@@ -72,7 +86,9 @@ namespace dmx {
     }
   }
 
-  void setup() {
+  void setup(const dmx_frame_config_t *config) {
+    frameConfig = config;
+
     pinMode(PIN_DRV_EN, OUTPUT);
     pinMode(PIN_RCV_EN, OUTPUT);
 
@@ -82,7 +98,17 @@ namespace dmx {
     Serial1.begin(BAUD_DMX, SERIAL_8N2);
   }
 
+  //timestamps at each step cost a few cycles each, against milliseconds on the wire
   void send(const uint8_t *data, const uint32_t len) {
+    //the line idles at mark between frames, short frames wait out the rest of the minimum frame time,
+    //which blocks the render thread as much as the frame itself
+    const uint32_t holdStartUs = micros();
+
+    delayMicroseconds(dmxFrame::markBeforeBreakUs(frameConfig, holdStartUs - lastBreakUs));
+
+    const uint32_t startUs = micros();
+    lastBreakUs = startUs;
+
     driverControl(ENABLE);
 
     //send the break and mark after break for DMX by sending a break at a slower
@@ -91,12 +117,101 @@ namespace dmx {
     Serial1.write(CHAR_BREAK);
     Serial1.flush();
 
+    const uint32_t breakEndUs = micros();
+
     configureBaudRate(USART1, BAUD_DMX);
     Serial1.write(START_CODE_NULL);
 
+    const uint32_t slotsStartUs = micros();
+
     Serial1.write(data, len);
     Serial1.flush();
 
     driverControl(DISABLE);
+
+    txStats.frameSent(holdStartUs, startUs, breakEndUs, slotsStartUs, micros(), len + 1);
+  }
+
+  DmxTxStats* transmitStats() {
+    return &txStats;
+  }
+
+  static void stopReceiveDma() {
+    DMA_Cmd(RX_DMA_STREAM, DISABLE);
+    while (DMA_GetCmdStatus(RX_DMA_STREAM) != DISABLE);
+  }
+
+  //must be rearmed within the mark after break and start code, at least 52us
+  static void armReceiveDma(uint8_t *buffer) {
+    DMA_ClearFlag(RX_DMA_STREAM, RX_DMA_FLAGS);
+    RX_DMA_STREAM->M0AR = (uint32_t)buffer;
+    RX_DMA_STREAM->NDTR = DMX_RECEIVE_BUFFER_SIZE;
+    DMA_Cmd(RX_DMA_STREAM, ENABLE);
+  }
+
+  //with DMA reception the USART only interrupts on errors, the break is the framing error
+  //that ends each frame
+  static void onUsartInterrupt() {
+    if ((USART1->SR & USART_FLAG_FE) == 0) {
+      //clear noise or overrun errors, the bytes still went to DMA
+      (void)USART1->SR;
+      (void)USART1->DR;
+      return;
+    }
+
+    stopReceiveDma();
+
+    const uint16_t status = USART1->SR;
+    uint32_t received = DMX_RECEIVE_BUFFER_SIZE - DMA_GetCurrDataCounter(RX_DMA_STREAM);
+
+    //the break's 0 is still waiting if DMA was stopped before it took it
+    if ((status & USART_FLAG_RXNE) != 0) {
+      received++;
+    }
+
+    //reading the data clears the error flags
+    (void)USART1->DR;
+
+    armReceiveDma(frameReceiver.onBreak(received, (status & USART_FLAG_ORE) != 0, millis()));
+  }
+
+  void setupReceiver() {
+    pinMode(PIN_DRV_EN, OUTPUT);
+    pinMode(PIN_RCV_EN, OUTPUT);
+
+    driverControl(DISABLE);
+    receiverControl(ENABLE);
+
+    Serial1.begin(BAUD_DMX, SERIAL_8N2);
+
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_DMA2, ENABLE);
+    stopReceiveDma();
+
+    DMA_InitTypeDef dmaInit;
+    DMA_StructInit(&dmaInit);
+    dmaInit.DMA_Channel = RX_DMA_CHANNEL;
+    dmaInit.DMA_PeripheralBaseAddr = (uint32_t)&USART1->DR;
+    dmaInit.DMA_Memory0BaseAddr = (uint32_t)frameReceiver.captureBuffer();
+    dmaInit.DMA_DIR = DMA_DIR_PeripheralToMemory;
+    dmaInit.DMA_BufferSize = DMX_RECEIVE_BUFFER_SIZE;
+    dmaInit.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    dmaInit.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    dmaInit.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    dmaInit.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    dmaInit.DMA_Mode = DMA_Mode_Normal;
+    dmaInit.DMA_Priority = DMA_Priority_High;
+    DMA_Init(RX_DMA_STREAM, &dmaInit);
+
+    //take the USART interrupt over from Serial1's receive buffer, bytes go to DMA instead
+    attachInterruptDirect(USART1_IRQn, onUsartInterrupt);
+    USART_ITConfig(USART1, USART_IT_RXNE, DISABLE);
+    USART_DMACmd(USART1, USART_DMAReq_Rx, ENABLE);
+    USART_ITConfig(USART1, USART_IT_ERR, ENABLE);
+
+    armReceiveDma(frameReceiver.captureBuffer());
+  }
+
+  DmxReceiver* receiver() {
+    return &frameReceiver;
   }
 }
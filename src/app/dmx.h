@@ -2,11 +2,24 @@
 #define OBELISK_DMX_H
 
 #include "Particle.h"
+#include "dmxFrame.h"
+#include "dmxReceiver.h"
+#include "dmxStats.h"
 
 namespace dmx {
-  void setup();
+  /* @param config frame timing, held for the life of the output */
+  void setup(const dmx_frame_config_t *config);
 
   void send(const uint8_t *data, const uint32_t len);
+
+  /* Frames sent and their wire time */
+  DmxTxStats* transmitStats();
+
+  /* Receive frames from a console instead of sending them, the port is half duplex */
+  void setupReceiver();
+
+  /* Frames received since setupReceiver() */
+  DmxReceiver* receiver();
 }
 
 #endif
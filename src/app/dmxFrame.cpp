@@ -0,0 +1,15 @@
+#include "dmxFrame.h"
+
+uint32_t dmxFrame::length(const dmx_frame_config_t *config, uint32_t usedSlots) {
+  uint32_t slots = config->startSlot + usedSlots;
+
+  if (slots < config->minSlots) {
+    slots = config->minSlots;
+  }
+
+  return slots < DMX_UNIVERSE_SLOTS ? slots : DMX_UNIVERSE_SLOTS;
+}
+
+uint32_t dmxFrame::markBeforeBreakUs(const dmx_frame_config_t *config, uint32_t sinceLastBreakUs) {
+  return sinceLastBreakUs < config->breakToBreakMinUs ? config->breakToBreakMinUs - sinceLastBreakUs : 0;
+}
@@ -0,0 +1,34 @@
+#ifndef OBELISK_DMX_FRAME_H
+#define OBELISK_DMX_FRAME_H
+
+#include "Particle.h"
+
+#define DMX_UNIVERSE_SLOTS 512
+
+typedef struct {
+  uint16_t startSlot;         /* slot the strip's first value is patched to, from 0 */
+  uint16_t minSlots;          /* shorter frames are padded with 0s, for receivers that need a full frame */
+  uint32_t breakToBreakMinUs; /* shortest time between the start of one frame and the next */
+} dmx_frame_config_t;
+
+/*
+ * Sizes DMX frames to the slots in use, so small strips aren't held up sending
+ * the rest of the universe, while keeping to the frame length and timing
+ * receivers accept.
+ */
+namespace dmxFrame {
+  /**
+   * Slots to send for usedSlots patched from the start slot
+   * @return up to the last patched slot, at least minSlots and at most a universe
+   */
+  uint32_t length(const dmx_frame_config_t *config, uint32_t usedSlots);
+
+  /**
+   * Mark before break to hold before the next frame, so short frames don't come
+   * round faster than receivers can take them
+   * @param sinceLastBreakUs time since the last frame started
+   */
+  uint32_t markBeforeBreakUs(const dmx_frame_config_t *config, uint32_t sinceLastBreakUs);
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include "dmxMerge.h"
+#include <string.h>
+
+static const uint32_t HIGH_BITS = 0x80808080;
+static const uint32_t LOW_BITS = 0x7F7F7F7F;
+
+//0xFF in each byte whose high bit is set
+static inline uint32_t expandHighBits(uint32_t bits) {
+  return ((bits & HIGH_BITS) >> 7) * 0xFF;
+}
+
+//0xFF in each byte where a >= b. The low 7 bits are compared with the high bit of a set, so
+//the subtraction never borrows from the next byte, then the high bits decide where they differ.
+static inline uint32_t greaterOrEqual(uint32_t a, uint32_t b) {
+  const uint32_t low = (a | HIGH_BITS) - (b & LOW_BITS);
+
+  return expandHighBits((a & ~b) | (~(a ^ b) & low));
+}
+
+//0xFF in each byte that differs
+static inline uint32_t changed(uint32_t a, uint32_t b) {
+  const uint32_t diff = a ^ b;
+
+  return expandHighBits(((diff & LOW_BITS) + LOW_BITS) | diff);
+}
+
+static inline uint32_t select(uint32_t mask, uint32_t a, uint32_t b) {
+  return (a & mask) | (b & ~mask);
+}
+
+//the tail of the strip is read as 0 past the end and only its slots are written
+static inline uint32_t loadTail(const uint8_t *values, uint32_t length) {
+  uint32_t word = 0;
+  memcpy(&word, values, length);
+  return word;
+}
+
+DmxMerge::DmxMerge(const merge_range_t *ranges, uint32_t numRanges) {
+  uint8_t modes[DMX_MERGE_WORDS * 4];
+
+  memset(modes, mergePattern, sizeof(modes));
+
+  for (uint32_t i=0; i<numRanges; i++) {
+    for (uint32_t slot=ranges[i].first; slot<ranges[i].first + ranges[i].count && slot<sizeof(modes); slot++) {
+      modes[slot] = ranges[i].mode;
+    }
+  }
+
+  for (uint32_t i=0; i<DMX_MERGE_WORDS; i++) {
+    uint32_t input = 0, htp = 0, ltp = 0;
+
+    //the masks are in memory order like the words loaded from the values, little endian
+    for (uint32_t byte=0; byte<4; byte++) {
+      const MergeMode mode = (MergeMode)modes[i * 4 + byte];
+      const uint32_t mask = 0xFFUL << (byte * 8);
+
+      input |= mode == mergeInput ? mask : 0;
+      htp |= mode == mergeHtp ? mask : 0;
+      ltp |= mode == mergeLtp ? mask : 0;
+    }
+
+    mInputMask[i] = input;
+    mHtpMask[i] = htp;
+    mLtpMask[i] = ltp;
+  }
+
+  memset(mInputOwns, 0, sizeof(mInputOwns));
+  memset(mLastInput, 0, sizeof(mLastInput));
+  memset(mLastPattern, 0, sizeof(mLastPattern));
+}
+
+inline uint32_t DmxMerge::mergeWord(uint32_t i, uint32_t fromPattern, uint32_t fromInput) {
+  //a slot changed by the console is its until the pattern changes it, the console wins a tie
+  const uint32_t inputChanged = changed(fromInput, mLastInput[i]);
+  const uint32_t patternChanged = changed(fromPattern, mLastPattern[i]);
+  const uint32_t inputOwns = inputChanged | (mInputOwns[i] & ~patternChanged);
+
+  mInputOwns[i] = inputOwns;
+  mLastInput[i] = fromInput;
+  mLastPattern[i] = fromPattern;
+
+  const uint32_t htp = select(greaterOrEqual(fromInput, fromPattern), fromInput, fromPattern);
+  const uint32_t ltp = select(inputOwns, fromInput, fromPattern);
+
+  return (fromPattern & ~(mInputMask[i] | mHtpMask[i] | mLtpMask[i])) |
+         (fromInput & mInputMask[i]) |
+         (htp & mHtpMask[i]) |
+         (ltp & mLtpMask[i]);
+}
+
+//the values aren't word aligned, the fixed size copies compile to single unaligned loads and stores
+void DmxMerge::merge(uint8_t *output, const uint8_t *pattern, const uint8_t *input, uint32_t length) {
+  if (length > DMX_MERGE_WORDS * 4) {
+    length = DMX_MERGE_WORDS * 4;
+  }
+
+  const uint32_t words = length / 4;
+  const uint32_t tail = length % 4;
+
+  for (uint32_t i=0; i<words; i++) {
+    uint32_t fromPattern, fromInput;
+
+    memcpy(&fromPattern, &pattern[i * 4], 4);
+    memcpy(&fromInput, &input[i * 4], 4);
+
+    const uint32_t merged = mergeWord(i, fromPattern, fromInput);
+    memcpy(&output[i * 4], &merged, 4);
+  }
+
+  if (tail > 0) {
+    const uint32_t offset = words * 4;
+    const uint32_t merged = mergeWord(words, loadTail(&pattern[offset], tail), loadTail(&input[offset], tail));
+
+    memcpy(&output[offset], &merged, tail);
+  }
+}
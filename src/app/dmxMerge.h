@@ -0,0 +1,53 @@
+#ifndef OBELISK_DMX_MERGE_H
+#define OBELISK_DMX_MERGE_H
+
+#include "Particle.h"
+#include "config.h"
+
+/* merged a word of 4 slots at a time */
+#define DMX_MERGE_WORDS ((NUM_LEDS * COLOURS_PER_LED + 3) / 4)
+
+/* How the console's value for a slot combines with the pattern's */
+enum MergeMode : uint8_t {
+  mergePattern, /* the pattern only */
+  mergeInput,   /* the console only */
+  mergeHtp,     /* highest takes precedence */
+  mergeLtp      /* latest takes precedence, whichever last changed the slot */
+};
+
+typedef struct {
+  uint16_t first; /* first LED value, from 0 */
+  uint16_t count;
+  MergeMode mode;
+} merge_range_t;
+
+/*
+ * Merges console input with the rendered pattern before it's sent, in one
+ * branchless pass over the slots 4 at a time. Slots outside the ranges show
+ * the pattern.
+ */
+class DmxMerge {
+private:
+  //byte masks of the slots in each mode, the rest are the pattern's
+  uint32_t mInputMask[DMX_MERGE_WORDS];
+  uint32_t mHtpMask[DMX_MERGE_WORDS];
+  uint32_t mLtpMask[DMX_MERGE_WORDS];
+
+  //latest takes precedence state, the slots the console last changed and the values last seen
+  uint32_t mInputOwns[DMX_MERGE_WORDS];
+  uint32_t mLastInput[DMX_MERGE_WORDS];
+  uint32_t mLastPattern[DMX_MERGE_WORDS];
+
+  uint32_t mergeWord(uint32_t i, uint32_t fromPattern, uint32_t fromInput);
+
+public:
+  DmxMerge(const merge_range_t *ranges, uint32_t numRanges);
+
+  /**
+   * @param output may be either of the inputs
+   * @param length values in each, at most NUM_LEDS * COLOURS_PER_LED
+   */
+  void merge(uint8_t *output, const uint8_t *pattern, const uint8_t *input, uint32_t length);
+};
+
+#endif
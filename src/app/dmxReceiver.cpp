@@ -0,0 +1,93 @@
+#include "dmxReceiver.h"
+#include <atomic>
+#include <string.h>
+
+static const uint8_t START_CODE_NULL = 0;
+/* moving average of the frame interval in 1/16ms, weighted 1/8 to the newest */
+static const uint32_t INTERVAL_SHIFT = 4;
+static const uint32_t INTERVAL_WEIGHT_SHIFT = 3;
+
+DmxReceiver::DmxReceiver(uint32_t timeoutMs) {
+  memset(mBuffers, 0, sizeof(mBuffers));
+  mSlots[0] = 0;
+  mSlots[1] = 0;
+  mCapture = 0;
+  mSynced = false;
+  mTimeoutMs = timeoutMs;
+  mLastFrameMs = 0;
+  mIntervalMs16 = 0;
+  memset(&mStats, 0, sizeof(mStats));
+}
+
+//a gap longer than the timeout is the signal coming back rather than the frame rate
+void DmxReceiver::updateInterval(uint32_t nowMs) {
+  const uint32_t intervalMs = nowMs - mLastFrameMs;
+
+  if (mStats.frames > 0 && intervalMs < mTimeoutMs) {
+    const int32_t sample = (int32_t)(intervalMs << INTERVAL_SHIFT);
+    const int32_t average = (int32_t)mIntervalMs16;
+
+    mIntervalMs16 = average == 0 ? sample : average + ((sample - average) >> INTERVAL_WEIGHT_SHIFT);
+    mStats.intervalUs = (mIntervalMs16 * 1000) >> INTERVAL_SHIFT;
+  }
+
+  mLastFrameMs = nowMs;
+}
+
+uint8_t* DmxReceiver::onBreak(uint32_t received, bool overrun, uint32_t nowMs) {
+  const uint8_t *frame = mBuffers[mCapture];
+
+  if (!mSynced) {
+    mSynced = true;
+    return mBuffers[mCapture];
+  }
+
+  //the break reads as a 0 with a framing error, so the frame is the bytes before it
+  if (overrun || received > DMX_RECEIVE_BUFFER_SIZE) {
+    mStats.longFrames++;
+  } else if (received < 3) {
+    mStats.shortFrames++;
+  } else if (frame[0] != START_CODE_NULL) {
+    mStats.otherStartCodes++;
+  } else {
+    mSlots[mCapture] = received - 2;
+    mStats.slots = received - 2;
+    updateInterval(nowMs);
+    mCapture ^= 1;
+
+    //readers check the count to see if the frame changed under them
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    mStats.frames++;
+  }
+
+  return mBuffers[mCapture];
+}
+
+//the interrupt can swap the buffers during the copy, then the old frame is being overwritten
+uint32_t DmxReceiver::read(uint8_t *output, uint32_t firstSlot, uint32_t length) {
+  uint32_t frames;
+  uint32_t available;
+
+  do {
+    frames = mStats.frames;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    const uint8_t front = mCapture ^ 1;
+    const uint32_t slots = frames == 0 ? 0 : mSlots[front];
+
+    available = slots > firstSlot ? slots - firstSlot : 0;
+    available = available < length ? available : length;
+
+    memcpy(output, &mBuffers[front][1 + firstSlot], available);
+
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  } while (frames != mStats.frames);
+
+  memset(&output[available], 0, length - available);
+
+  return available;
+}
+
+bool DmxReceiver::isLive(uint32_t nowMs) {
+  return mStats.frames > 0 && nowMs - mLastFrameMs < mTimeoutMs;
+}
@@ -0,0 +1,67 @@
+#ifndef OBELISK_DMX_RECEIVER_H
+#define OBELISK_DMX_RECEIVER_H
+
+#include "Particle.h"
+#include "dmxFrame.h"
+
+/* start code, a full universe and the break that ends the frame */
+#define DMX_RECEIVE_BUFFER_SIZE (1 + DMX_UNIVERSE_SLOTS + 1)
+
+typedef struct {
+  uint32_t frames;         /* complete frames received */
+  uint32_t shortFrames;    /* breaks with no slots before them, usually noise on the line */
+  uint32_t longFrames;     /* frames longer than a universe, dropped */
+  uint32_t otherStartCodes; /* frames with an alternate start code (RDM, text), dropped */
+  uint32_t intervalUs;     /* moving average of the time between frames */
+  uint32_t slots;          /* slots in the last frame */
+} dmx_receiver_stats_t;
+
+/*
+ * Frames captured by DMA and ended by the break of the next one. The DMA writes
+ * into one buffer while the last complete frame is read from the other, they
+ * swap on each good frame.
+ */
+class DmxReceiver {
+private:
+  uint8_t mBuffers[2][DMX_RECEIVE_BUFFER_SIZE];
+  uint16_t mSlots[2];
+  uint8_t mCapture;
+  bool mSynced;
+  uint32_t mTimeoutMs;
+  uint32_t mLastFrameMs;
+  uint32_t mIntervalMs16;
+  dmx_receiver_stats_t mStats;
+
+  void updateInterval(uint32_t nowMs);
+
+public:
+  /* Frames are no longer live timeoutMs after the last one */
+  DmxReceiver(uint32_t timeoutMs);
+
+  /* Buffer for DMA to capture the next frame into */
+  uint8_t* captureBuffer() { return mBuffers[mCapture]; };
+
+  /**
+   * Called from the break interrupt. The first break only lines up with the
+   * frames, as reception may have started part way through one.
+   * @param received bytes DMA wrote since it was armed, the break's 0 included
+   * @param overrun the USART lost bytes once the buffer was full
+   * @return buffer to capture the next frame into
+   */
+  uint8_t* onBreak(uint32_t received, bool overrun, uint32_t nowMs);
+
+  /**
+   * Copy slots from the last complete frame, safe against a frame completing
+   * part way through. Slots past the end of the frame read as 0.
+   * @param firstSlot first slot to copy, from 0
+   * @return number of slots the frame had values for
+   */
+  uint32_t read(uint8_t *output, uint32_t firstSlot, uint32_t length);
+
+  /* Whether a frame arrived within the timeout */
+  bool isLive(uint32_t nowMs);
+
+  const dmx_receiver_stats_t* stats() { return &mStats; };
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "dmxStats.h"
+#include <stdio.h>
+#include <string.h>
+
+/* moving averages are weighted 1/8 to the newest frame */
+static const uint32_t AVERAGE_WEIGHT_SHIFT = 3;
+
+static uint32_t average(uint32_t average, uint32_t sample) {
+  if (average == 0) {
+    return sample;
+  }
+
+  return (uint32_t)((int32_t)average + (((int32_t)sample - (int32_t)average) >> AVERAGE_WEIGHT_SHIFT));
+}
+
+DmxTxStats::DmxTxStats(uint32_t breakStopUs) {
+  mBreakStopUs = breakStopUs;
+  mLastFrameUs = 0;
+  mBlockedRemainderUs = 0;
+  memset(&mStats, 0, sizeof(mStats));
+}
+
+void DmxTxStats::frameSent(uint32_t holdStartUs, uint32_t startUs, uint32_t breakEndUs, uint32_t slotsStartUs, uint32_t endUs, uint32_t bytes) {
+  const uint32_t breakCharUs = breakEndUs - startUs;
+  const uint32_t blockedUs = endUs - holdStartUs;
+
+  mStats.holdUs = startUs - holdStartUs;
+
+  //the break is sent as a slow 0, its stop bits are the start of the mark after break
+  mStats.breakUs = breakCharUs > mBreakStopUs ? breakCharUs - mBreakStopUs : 0;
+  mStats.mabUs = breakCharUs - mStats.breakUs + (slotsStartUs - breakEndUs);
+  mStats.slotsUs = endUs - slotsStartUs;
+  mStats.blockedUs = average(mStats.blockedUs, blockedUs);
+
+  mBlockedRemainderUs += blockedUs;
+  mStats.blockedMs += mBlockedRemainderUs / 1000;
+  mBlockedRemainderUs %= 1000;
+
+  if (mStats.frames > 0) {
+    mStats.intervalUs = average(mStats.intervalUs, startUs - mLastFrameUs);
+  }
+
+  mLastFrameUs = startUs;
+  mStats.frames++;
+  mStats.bytes += bytes;
+}
+
+uint32_t DmxTxStats::refreshRate10() {
+  return mStats.intervalUs > 0 ? 10000000 / mStats.intervalUs : 0;
+}
+
+uint32_t DmxTxStats::summary(char *output, uint32_t size) {
+  const uint32_t rate10 = refreshRate10();
+  const int written = snprintf(output, size, "%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu.%lu",
+                               (unsigned long)mStats.frames,
+                               (unsigned long)mStats.bytes,
+                               (unsigned long)mStats.holdUs,
+                               (unsigned long)mStats.breakUs,
+                               (unsigned long)mStats.mabUs,
+                               (unsigned long)mStats.slotsUs,
+                               (unsigned long)mStats.blockedUs,
+                               (unsigned long)mStats.blockedMs,
+                               (unsigned long)(rate10 / 10),
+                               (unsigned long)(rate10 % 10));
+
+  return written < 0 ? 0 : ((uint32_t)written < size ? written : size - 1);
+}
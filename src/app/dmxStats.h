@@ -0,0 +1,58 @@
+#ifndef OBELISK_DMX_STATS_H
+#define OBELISK_DMX_STATS_H
+
+#include "Particle.h"
+
+/* '<frames>,<bytes>,<hold>,<break>,<mab>,<slots>,<blocked>,<blocked total ms>,<rate>' */
+#define DMX_STATS_SUMMARY_SIZE 96
+
+typedef struct {
+  uint32_t frames;      /* frames sent */
+  uint32_t bytes;       /* start codes and slots sent */
+  uint32_t holdUs;      /* last frame's mark before break, held out to the minimum frame time */
+  uint32_t breakUs;     /* last frame's break */
+  uint32_t mabUs;       /* last frame's mark after break, including switching back to the DMX baud rate */
+  uint32_t slotsUs;     /* last frame's start code and slots, to the end of the last stop bit */
+  uint32_t blockedUs;   /* moving average of the time each send blocks the render thread, the hold included */
+  uint32_t blockedMs;   /* total time blocked */
+  uint32_t intervalUs;  /* moving average of the time between frames */
+} dmx_tx_stats_t;
+
+/*
+ * Wire time of each DMX frame sent, from timestamps taken as send() moves
+ * between the break, the slots and waiting for the last byte to go out.
+ */
+class DmxTxStats {
+private:
+  uint32_t mBreakStopUs;
+  uint32_t mLastFrameUs;
+  uint32_t mBlockedRemainderUs;
+  dmx_tx_stats_t mStats;
+
+public:
+  /* @param breakStopUs the stop bits of the break character, the start of the mark after break */
+  DmxTxStats(uint32_t breakStopUs);
+
+  /**
+   * Called once each frame has gone out, times are micros()
+   * @param holdStartUs send() called, the line is held at mark before the break
+   * @param startUs the break starts
+   * @param breakEndUs the break character's stop bits have gone out
+   * @param slotsStartUs the start code is queued at the DMX baud rate
+   * @param endUs the last slot has gone out
+   * @param bytes start code and slots
+   */
+  void frameSent(uint32_t holdStartUs, uint32_t startUs, uint32_t breakEndUs, uint32_t slotsStartUs, uint32_t endUs, uint32_t bytes);
+
+  /* Achieved refresh rate in tenths of Hz */
+  uint32_t refreshRate10();
+
+  /**
+   * @return number of characters written, excluding the terminator
+   */
+  uint32_t summary(char *output, uint32_t size);
+
+  const dmx_tx_stats_t* stats() { return &mStats; };
+};
+
+#endif
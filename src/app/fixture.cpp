@@ -0,0 +1,172 @@
+#include "fixture.h"
+#include "config.h"
+
+namespace fixture {
+  /*
+   * Writes one channel of a pixel. Specialised per channel type so a profile's
+   * packer is a straight run of stores with no per-pixel branching.
+   */
+  template <FixtureChannel C>
+  struct Channel;
+
+  template <>
+  struct Channel<channelRed> {
+    static const uint8_t SLOTS = 1;
+    static void write(uint8_t *dst, const uint8_t *rgb, uint8_t white, const uint8_t *defaults) {
+      dst[0] = rgb[INDEX_RED] - white;
+    }
+  };
+
+  template <>
+  struct Channel<channelGreen> {
+    static const uint8_t SLOTS = 1;
+    static void write(uint8_t *dst, const uint8_t *rgb, uint8_t white, const uint8_t *defaults) {
+      dst[0] = rgb[INDEX_GREEN] - white;
+    }
+  };
+
+  template <>
+  struct Channel<channelBlue> {
+    static const uint8_t SLOTS = 1;
+    static void write(uint8_t *dst, const uint8_t *rgb, uint8_t white, const uint8_t *defaults) {
+      dst[0] = rgb[INDEX_BLUE] - white;
+    }
+  };
+
+  template <>
+  struct Channel<channelWhite> {
+    static const uint8_t SLOTS = 1;
+    static void write(uint8_t *dst, const uint8_t *rgb, uint8_t white, const uint8_t *defaults) {
+      dst[0] = white;
+    }
+  };
+
+  //patterns render 8 bits, repeating them in the fine slot makes full scale 0xFFFF
+  template <>
+  struct Channel<channelRed16> {
+    static const uint8_t SLOTS = 2;
+    static void write(uint8_t *dst, const uint8_t *rgb, uint8_t white, const uint8_t *defaults) {
+      dst[0] = dst[1] = rgb[INDEX_RED];
+    }
+  };
+
+  template <>
+  struct Channel<channelGreen16> {
+    static const uint8_t SLOTS = 2;
+    static void write(uint8_t *dst, const uint8_t *rgb, uint8_t white, const uint8_t *defaults) {
+      dst[0] = dst[1] = rgb[INDEX_GREEN];
+    }
+  };
+
+  template <>
+  struct Channel<channelBlue16> {
+    static const uint8_t SLOTS = 2;
+    static void write(uint8_t *dst, const uint8_t *rgb, uint8_t white, const uint8_t *defaults) {
+      dst[0] = dst[1] = rgb[INDEX_BLUE];
+    }
+  };
+
+  template <>
+  struct Channel<channelFixed> {
+    static const uint8_t SLOTS = 1;
+    static void write(uint8_t *dst, const uint8_t *rgb, uint8_t white, const uint8_t *defaults) {
+      dst[0] = defaults[0];
+    }
+  };
+
+  //the channels of a pixel in slot order, unrolled at compile time
+  template <FixtureChannel... C>
+  struct Pixel;
+
+  template <>
+  struct Pixel<> {
+    static const uint8_t SLOTS = 0;
+    static const bool HAS_WHITE = false;
+    static void write(uint8_t *dst, const uint8_t *rgb, uint8_t white, const uint8_t *defaults) {}
+  };
+
+  template <FixtureChannel C, FixtureChannel... Rest>
+  struct Pixel<C, Rest...> {
+    static const uint8_t SLOTS = Channel<C>::SLOTS + Pixel<Rest...>::SLOTS;
+    static const bool HAS_WHITE = C == channelWhite || Pixel<Rest...>::HAS_WHITE;
+
+    static void write(uint8_t *dst, const uint8_t *rgb, uint8_t white, const uint8_t *defaults) {
+      Channel<C>::write(dst, rgb, white, defaults);
+      Pixel<Rest...>::write(dst + Channel<C>::SLOTS, rgb, white, defaults + Channel<C>::SLOTS);
+    }
+  };
+
+  static inline uint8_t min3(uint8_t a, uint8_t b, uint8_t c) {
+    const uint8_t ab = a < b ? a : b;
+    return ab < c ? ab : c;
+  }
+
+  template <FixtureChannel... C>
+  struct Profile {
+    static const uint8_t SLOTS = Pixel<C...>::SLOTS;
+
+    static void pack(uint8_t *output, const uint8_t *values, const uint16_t *map, uint32_t numLeds,
+                     const uint8_t *defaults) {
+      for (uint32_t i=0; i < numLeds; i++) {
+        const uint8_t *rgb = &values[map[i] * COLOURS_PER_LED];
+        const uint8_t white = Pixel<C...>::HAS_WHITE ?
+                              min3(rgb[INDEX_RED], rgb[INDEX_GREEN], rgb[INDEX_BLUE]) : 0;
+
+        Pixel<C...>::write(&output[i * SLOTS], rgb, white, defaults);
+      }
+    }
+  };
+
+  typedef Profile<channelRed, channelGreen, channelBlue> ProfileRgb;
+  typedef Profile<channelGreen, channelRed, channelBlue> ProfileGrb;
+  typedef Profile<channelRed, channelGreen, channelBlue, channelWhite> ProfileRgbw;
+  typedef Profile<channelRed, channelGreen, channelBlue, channelFixed> ProfileRgba;
+  typedef Profile<channelFixed, channelRed, channelGreen, channelBlue> ProfileDimmerRgb;
+  typedef Profile<channelRed16, channelGreen16, channelBlue16> ProfileRgb16;
+
+  static_assert(ProfileRgb16::SLOTS <= FIXTURE_SLOTS_MAX, "profile has more slots than FIXTURE_SLOTS_MAX");
+
+  const fixture_profile_t PROFILE_RGB = {
+    .name = "rgb",
+    .slots = ProfileRgb::SLOTS,
+    .defaults = {0},
+    .pack = ProfileRgb::pack,
+  };
+
+  const fixture_profile_t PROFILE_GRB = {
+    .name = "grb",
+    .slots = ProfileGrb::SLOTS,
+    .defaults = {0},
+    .pack = ProfileGrb::pack,
+  };
+
+  const fixture_profile_t PROFILE_RGBW = {
+    .name = "rgbw",
+    .slots = ProfileRgbw::SLOTS,
+    .defaults = {0},
+    .pack = ProfileRgbw::pack,
+  };
+
+  //patterns have no amber, so it stays off
+  const fixture_profile_t PROFILE_RGBA = {
+    .name = "rgba",
+    .slots = ProfileRgba::SLOTS,
+    .defaults = {0, 0, 0, 0},
+    .pack = ProfileRgba::pack,
+  };
+
+  //master dimmer at full, the patterns set the brightness
+  const fixture_profile_t PROFILE_DIMMER_RGB = {
+    .name = "drgb",
+    .slots = ProfileDimmerRgb::SLOTS,
+    .defaults = {255, 0, 0, 0},
+    .pack = ProfileDimmerRgb::pack,
+  };
+
+  const fixture_profile_t PROFILE_RGB16 = {
+    .name = "rgb16",
+    .slots = ProfileRgb16::SLOTS,
+    .defaults = {0},
+    .pack = ProfileRgb16::pack,
+  };
+}
@@ -0,0 +1,59 @@
+#ifndef OBELISK_FIXTURE_H
+#define OBELISK_FIXTURE_H
+
+#include "Particle.h"
+
+/* Most DMX slots a fixture profile uses per pixel */
+#define FIXTURE_SLOTS_MAX 8
+
+/* What drives each channel of a fixture */
+enum FixtureChannel : uint8_t {
+  channelRed,
+  channelGreen,
+  channelBlue,
+  channelWhite,   /* the part of red, green and blue they have in common, taken out of them */
+  channelRed16,   /* 16 bit channels take a coarse then a fine slot */
+  channelGreen16,
+  channelBlue16,
+  channelFixed    /* dimmer, amber, strobe, mode etc, held at the profile's default */
+};
+
+/*
+ * Slot layout of the pixels on a DMX output. The channel layout and bit depth
+ * are fixed by the packer, which is generated from the channel list in
+ * fixture.cpp, and the defaults give the value of the slots the patterns
+ * don't drive.
+ */
+typedef struct {
+  const char *name;
+  uint8_t slots;                        /* DMX slots per pixel */
+  uint8_t defaults[FIXTURE_SLOTS_MAX];  /* value of each slot held by a fixed channel */
+
+  /**
+   * Gather logical LED values into physical order and expand each into the
+   * profile's slots in a single pass
+   * @param output DMX slots, numLeds * slots long
+   * @param values logical LED values rendered by the patterns, RGB
+   * @param map physical to logical LED table, see pixelMap::build()
+   * @param numLeds number of physical LEDs
+   * @param defaults the profile's defaults
+   */
+  void (*pack)(uint8_t *output, const uint8_t *values, const uint16_t *map, uint32_t numLeds,
+               const uint8_t *defaults);
+} fixture_profile_t;
+
+namespace fixture {
+  extern const fixture_profile_t PROFILE_RGB;
+  extern const fixture_profile_t PROFILE_GRB;
+  extern const fixture_profile_t PROFILE_RGBW;
+  extern const fixture_profile_t PROFILE_RGBA;
+  extern const fixture_profile_t PROFILE_DIMMER_RGB;
+  extern const fixture_profile_t PROFILE_RGB16;
+
+  inline void pack(uint8_t *output, const uint8_t *values, const uint16_t *map, uint32_t numLeds,
+                   const fixture_profile_t *profile) {
+    profile->pack(output, values, map, numLeds, profile->defaults);
+  }
+}
+
+#endif
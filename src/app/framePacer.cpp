@@ -0,0 +1,93 @@
+#include "framePacer.h"
+#include <string.h>
+
+FramePacer::FramePacer(const frame_pacer_config_t *config) {
+  mConfig = config;
+  mIntervalMs = config->resolutionMs;
+  mLastFrameMs = 0;
+  mNextFrameMs = 0;
+  mDueFrames = 0;
+  mGoodFrames = 0;
+  memset(&mStats, 0, sizeof(mStats));
+  mStats.intervalMs = mIntervalMs;
+}
+
+void FramePacer::start(uint32_t nowMs) {
+  mLastFrameMs = nowMs;
+  mNextFrameMs = nowMs + mIntervalMs;
+}
+
+void FramePacer::holdFor(uint32_t waitMs) {
+  //the half tick cancels out the early allowance in tick(), so the frame isn't rendered before the change
+  mNextFrameMs = waitMs > mIntervalMs ? mLastFrameMs + waitMs + mConfig->resolutionMs / 2 :
+                                        mLastFrameMs + mIntervalMs;
+}
+
+void FramePacer::wake(uint32_t nowMs) {
+  if ((int32_t)(mNextFrameMs - nowMs) > 0) {
+    mNextFrameMs = nowMs;
+  }
+}
+
+void FramePacer::slowDown() {
+  mGoodFrames = 0;
+
+  if (mIntervalMs + mConfig->resolutionMs <= mConfig->intervalMaxMs) {
+    mIntervalMs += mConfig->resolutionMs;
+  }
+
+  mNextFrameMs = mLastFrameMs + mIntervalMs;
+}
+
+uint32_t FramePacer::tick(uint32_t nowMs) {
+  const int32_t lateMs = (int32_t)(nowMs - mNextFrameMs);
+
+  //ticks jitter, so a frame is due from half a tick early
+  if (lateMs + (int32_t)(mConfig->resolutionMs / 2) < 0) {
+    return 0;
+  }
+
+  mDueFrames = 1 + (lateMs > 0 ? lateMs / mIntervalMs : 0);
+
+  if (mDueFrames > 1) {
+    mStats.missedFrames += mDueFrames - 1;
+
+    if (mConfig->policy == overrunAdapt) {
+      slowDown();
+    }
+  }
+
+  mLastFrameMs = nowMs;
+  mNextFrameMs = nowMs + mIntervalMs;
+  mStats.intervalMs = mIntervalMs;
+
+  return mDueFrames;
+}
+
+uint32_t FramePacer::frameTime(uint32_t index) {
+  return mLastFrameMs - (mDueFrames - 1 - index) * mIntervalMs;
+}
+
+void FramePacer::frameDone(uint32_t startMs, uint32_t endMs) {
+  const uint32_t durationMs = endMs - startMs;
+
+  mStats.frames++;
+
+  if (durationMs > mIntervalMs) {
+    mStats.overruns++;
+
+    if (mConfig->policy == overrunAdapt) {
+      slowDown();
+    }
+  } else if (mConfig->policy == overrunAdapt && durationMs < mIntervalMs / 2) {
+    mGoodFrames++;
+
+    //speed back up a step at a time once frames fit comfortably
+    if (mGoodFrames >= mConfig->recoverFrames && mIntervalMs > mConfig->resolutionMs) {
+      mIntervalMs -= mConfig->resolutionMs;
+      mGoodFrames = 0;
+    }
+  }
+
+  mStats.intervalMs = mIntervalMs;
+}
@@ -0,0 +1,71 @@
+#ifndef OBELISK_FRAME_PACER_H
+#define OBELISK_FRAME_PACER_H
+
+#include "Particle.h"
+
+/* What to do about frames lost when the timer callback runs late */
+enum OverrunPolicy {
+  overrunSkip,         /* render the present only */
+  overrunRenderMissed, /* render the lost frames too, without sending them */
+  overrunAdapt         /* lower the frame rate while frames overrun */
+};
+
+typedef struct {
+  uint32_t frames;       /* frames sent */
+  uint32_t overruns;     /* frames that took longer than the frame interval */
+  uint32_t missedFrames; /* frames lost to late or coalesced timer callbacks */
+  uint32_t intervalMs;   /* current frame interval */
+} frame_stats_t;
+
+typedef struct {
+  uint32_t resolutionMs;   /* timer period */
+  OverrunPolicy policy;
+  uint32_t intervalMaxMs;  /* slowest frame interval the adaptive policy backs off to */
+  uint32_t recoverFrames;  /* frames well inside the interval before the adaptive policy speeds up */
+} frame_pacer_config_t;
+
+/*
+ * Decides which timer ticks render a frame, measured against a monotonic
+ * clock rather than trusting the timer, and keeps count of the frames lost.
+ * Frames can be held back while the pattern isn't changing.
+ */
+class FramePacer {
+private:
+  const frame_pacer_config_t *mConfig;
+  uint32_t mIntervalMs;
+  uint32_t mLastFrameMs;
+  uint32_t mNextFrameMs;
+  uint32_t mDueFrames;
+  uint32_t mGoodFrames;
+  frame_stats_t mStats;
+
+  void slowDown();
+
+public:
+  FramePacer(const frame_pacer_config_t *config);
+
+  void start(uint32_t nowMs);
+
+  /**
+   * Called on every timer tick
+   * @return frames due since the last one, 0 = not due yet. More than 1 means
+   *         frames were missed, the last is the present.
+   */
+  uint32_t tick(uint32_t nowMs);
+
+  /* Time the given frame returned by tick() was due, frames before the last are in the past */
+  uint32_t frameTime(uint32_t index);
+
+  /* Called once the present frame has been sent */
+  void frameDone(uint32_t startMs, uint32_t endMs);
+
+  /* Don't render another frame until waitMs after the last one, for patterns that aren't changing */
+  void holdFor(uint32_t waitMs);
+
+  /* Render on the next tick, cutting short any hold */
+  void wake(uint32_t nowMs);
+
+  const frame_stats_t* stats() { return &mStats; };
+};
+
+#endif
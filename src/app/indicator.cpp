@@ -0,0 +1,17 @@
+#include "indicator.h"
+
+void indicator::set(indicator_t *indicator, uint16_t periodMs, uint16_t onMs) {
+  indicator->periodMs = periodMs;
+  indicator->onMs = onMs;
+  indicator->elapsedMs = 0;
+}
+
+bool indicator::tick(indicator_t *indicator, uint32_t elapsedMs) {
+  const bool on = indicator->elapsedMs < indicator->onMs;
+
+  if (indicator->periodMs > 0) {
+    indicator->elapsedMs = (indicator->elapsedMs + elapsedMs) % indicator->periodMs;
+  }
+
+  return on;
+}
@@ -0,0 +1,21 @@
+#ifndef OBELISK_INDICATOR_H
+#define OBELISK_INDICATOR_H
+
+#include "Particle.h"
+
+/* Blink state for a single on/off output, eg a status LED */
+typedef struct {
+  uint16_t periodMs;
+  uint16_t onMs;
+  uint16_t elapsedMs;
+} indicator_t;
+
+namespace indicator {
+  /* Flash with onMs on at the start of every period, onMs >= periodMs = steady on, 0 = off */
+  void set(indicator_t *indicator, uint16_t periodMs, uint16_t onMs);
+
+  /* Advance by elapsedMs, returning whether the output is on */
+  bool tick(indicator_t *indicator, uint32_t elapsedMs);
+}
+
+#endif
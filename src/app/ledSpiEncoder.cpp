@@ -0,0 +1,43 @@
+#include "ledSpiEncoder.h"
+
+namespace ledSpiEncoder {
+  //SPI bits for each nibble of LED data, 12 bits of 100/110 codes
+  static const uint16_t NIBBLE_3[16] = {
+    0x924, 0x926, 0x934, 0x936, 0x9A4, 0x9A6, 0x9B4, 0x9B6,
+    0xD24, 0xD26, 0xD34, 0xD36, 0xDA4, 0xDA6, 0xDB4, 0xDB6,
+  };
+
+  //16 bits of 1000/1110 codes
+  static const uint16_t NIBBLE_4[16] = {
+    0x8888, 0x888E, 0x88E8, 0x88EE, 0x8E88, 0x8E8E, 0x8EE8, 0x8EEE,
+    0xE888, 0xE88E, 0xE8E8, 0xE8EE, 0xEE88, 0xEE8E, 0xEEE8, 0xEEEE,
+  };
+
+  uint32_t encode3(uint8_t *output, const uint8_t *values, uint32_t length) {
+    for (uint32_t i=0; i < length; i++) {
+      const uint32_t bits = ((uint32_t)NIBBLE_3[values[i] >> 4] << 12) | NIBBLE_3[values[i] & 0xF];
+
+      output[0] = (uint8_t)(bits >> 16);
+      output[1] = (uint8_t)(bits >> 8);
+      output[2] = (uint8_t)bits;
+      output += 3;
+    }
+
+    return encodedLength(length, 3);
+  }
+
+  uint32_t encode4(uint8_t *output, const uint8_t *values, uint32_t length) {
+    for (uint32_t i=0; i < length; i++) {
+      const uint16_t high = NIBBLE_4[values[i] >> 4];
+      const uint16_t low = NIBBLE_4[values[i] & 0xF];
+
+      output[0] = (uint8_t)(high >> 8);
+      output[1] = (uint8_t)high;
+      output[2] = (uint8_t)(low >> 8);
+      output[3] = (uint8_t)low;
+      output += 4;
+    }
+
+    return encodedLength(length, 4);
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef OBELISK_LED_SPI_ENCODER_H
+#define OBELISK_LED_SPI_ENCODER_H
+
+#include "Particle.h"
+
+/*
+ * Encodes LED data for single wire addressable LEDs (WS2812, SK6812) as an SPI
+ * bit stream. Each LED bit is sent as 3 or 4 SPI bits, a short high pulse for a
+ * 0 and a long one for a 1: 100/110 or 1000/1110.
+ */
+namespace ledSpiEncoder {
+  /* Bytes of SPI data for length bytes of LED data */
+  inline uint32_t encodedLength(uint32_t length, uint8_t spiBits) {
+    return length * spiBits;
+  }
+
+  /**
+   * Encode LED bytes, most significant bit first, 3 SPI bits per LED bit
+   * @param output encodedLength(length, 3) bytes
+   * @return number of bytes written
+   */
+  uint32_t encode3(uint8_t *output, const uint8_t *values, uint32_t length);
+
+  /**
+   * Encode LED bytes, most significant bit first, 4 SPI bits per LED bit
+   * @param output encodedLength(length, 4) bytes
+   * @return number of bytes written
+   */
+  uint32_t encode4(uint8_t *output, const uint8_t *values, uint32_t length);
+
+  /* encode3() or encode4() by spiBits */
+  inline uint32_t encode(uint8_t *output, const uint8_t *values, uint32_t length, uint8_t spiBits) {
+    return spiBits == 4 ? encode4(output, values, length) : encode3(output, values, length);
+  }
+}
+
+#endif
@@ -1,44 +1,342 @@
 #include "Particle.h"
 #include "config.h"
+#include "apa102.h"
 #include "colour.h"
 #include "colours.h"
+#include "clockSync.h"
 #include "dmx.h"
+#include "dmxMerge.h"
+#include "fixture.h"
+#include "framePacer.h"
 #include "ledStripDriver.h"
 #include "ledStrip.h"
+#include "pixelMap.h"
+#include "profiler.h"
+#include "stream.h"
+#include "transition.h"
+#include "usbLink.h"
+#include "ws2812.h"
 
+//the cloud functions configure the staged driver, which is copied for the render thread to take up
+//on its next tick, so the driver being rendered from only ever changes between frames
 static LedStripDriver *ledDriver;
+static LedStripDriver *stagedDriver;
+static LedStripDriver *pendingDriver;
+static Colour liveColours[DRIVER_COLOUR_COUNT];
+static Colour pendingColours[DRIVER_COLOUR_COUNT];
+static Mutex pendingLock;
+static bool transitionPending;
+static uint32_t pendingDurationMs;
+static uint32_t pendingStartTime;
 static led_strip_state_t ledState;
 static uint8_t ledValues[NUM_LEDS * COLOURS_PER_LED];
-static const Colour COLOUR_START = COLOUR_BLUE;
-static const Colour COLOUR_END = COLOUR_BLACK;
+static uint8_t outgoingValues[NUM_LEDS * COLOURS_PER_LED];
+//a universe for DMX, the slots outside the strip's are left at 0, or the whole strip for pixel outputs
+static const uint32_t OUTPUT_VALUES_SIZE = NUM_LEDS * COLOURS_PER_LED > DMX_UNIVERSE_SLOTS ?
+  NUM_LEDS * COLOURS_PER_LED : DMX_UNIVERSE_SLOTS;
+static uint8_t outputValues[OUTPUT_VALUES_SIZE];
+static uint8_t inputValues[NUM_LEDS * COLOURS_PER_LED];
+static_assert(DMX_START_SLOT < DMX_UNIVERSE_SLOTS, "the DMX start slot is past the end of the universe");
+static_assert(!DMX_INPUT_ENABLED || LED_OUTPUT != outputDmx, "the DMX port is half duplex, DMX input needs a pixel strip output");
+static_assert(!DMX_INPUT_ENABLED || LED_SPI_PORT == 1, "DMX input takes DMA2 stream 2 from SPI, pixel strips need LED_SPI_PORT 1 with it");
+static_assert(LED_SPI_PORT == 0 || LED_SPI_PORT == 1, "LED_SPI_PORT is 0 for SPI or 1 for SPI1");
+static uint16_t ledMap[NUM_LEDS];
+static ClockSync clockSync;
+static uint32_t lastSyncSecond;
+static constexpr Colour COLOUR_START = COLOUR_BLUE;
+static constexpr Colour COLOUR_END = COLOUR_BLACK;
 
+static const merge_range_t MERGE_RANGES[] = DMX_MERGE_RANGES;
+static DmxMerge dmxMerge(MERGE_RANGES, sizeof(MERGE_RANGES) / sizeof(MERGE_RANGES[0]));
+
+static const pixel_map_config_t CONFIG_PIXEL_MAP = {
+  .numLeds = NUM_LEDS,
+  .offset = PIXEL_MAP_OFFSET,
+  .reverse = PIXEL_MAP_REVERSE,
+  .serpentineWidth = PIXEL_MAP_SERPENTINE_WIDTH,
+  .mirror = PIXEL_MAP_MIRROR,
+  .repeat = PIXEL_MAP_REPEAT,
+  .colourOrder = PIXEL_MAP_COLOUR_ORDER,
+};
+
+static const dmx_frame_config_t CONFIG_DMX_FRAME = {
+  .startSlot = DMX_START_SLOT,
+  .minSlots = DMX_FRAME_SLOTS_MIN,
+  .breakToBreakMinUs = DMX_BREAK_TO_BREAK_MIN_US,
+};
+
+//pixels that would run past the end of the universe from the start slot aren't sent
+static const uint32_t DMX_NUM_LEDS_MAX = (DMX_UNIVERSE_SLOTS - DMX_START_SLOT) / DMX_FIXTURE_PROFILE.slots;
+static const uint32_t DMX_NUM_LEDS = NUM_LEDS < DMX_NUM_LEDS_MAX ? NUM_LEDS : DMX_NUM_LEDS_MAX;
+
+//values are rendered in logical order and RGB, map to the physical order and fixture slots as they are
+//sent, in a frame that stops at the last pixel's slots
 static void updateLedsDmx(uint8_t *values, uint32_t length) {
-  dmx::send(values, length);
+  profiler::writeStart();
+  fixture::pack(&outputValues[DMX_START_SLOT], values, ledMap, DMX_NUM_LEDS, &DMX_FIXTURE_PROFILE);
+  dmx::send(outputValues, dmxFrame::length(&CONFIG_DMX_FRAME, DMX_NUM_LEDS * DMX_FIXTURE_PROFILE.slots));
+  profiler::writeEnd();
+}
+
+//pixel strips take the colour order straight from the pixel map
+static void updateLedsWs2812(uint8_t *values, uint32_t length) {
+  profiler::writeStart();
+  pixelMap::apply(outputValues, values, ledMap, NUM_LEDS, CONFIG_PIXEL_MAP.colourOrder);
+  ws2812::send(outputValues, NUM_LEDS * COLOURS_PER_LED);
+  profiler::writeEnd();
+}
+
+static void updateLedsApa102(uint8_t *values, uint32_t length) {
+  profiler::writeStart();
+  pixelMap::apply(outputValues, values, ledMap, NUM_LEDS, CONFIG_PIXEL_MAP.colourOrder);
+  apa102::send(outputValues, NUM_LEDS);
+  profiler::writeEnd();
+}
+
+static void (*const outputFn)(uint8_t *values, uint32_t length) =
+  LED_OUTPUT == outputWs2812 ? updateLedsWs2812 :
+  LED_OUTPUT == outputApa102 ? updateLedsApa102 : updateLedsDmx;
+
+static bool isSerialLive() {
+  return SERIAL_LINK_ENABLED && usbLink::link()->isLive(millis());
+}
+
+static bool isStreamLive() {
+  return STREAM_PROTOCOL != streamOff && stream::receiver()->isLive(millis());
+}
+
+static bool isInputLive() {
+  return isSerialLive() || isStreamLive() || (DMX_INPUT_ENABLED && dmx::receiver()->isLive(millis()));
+}
+
+//a PC on the USB port takes priority over a network stream, which takes priority over the DMX port
+static bool readInput() {
+  if (isSerialLive()) {
+    usbLink::link()->read(inputValues, DMX_INPUT_START_SLOT, sizeof(inputValues));
+    return true;
+  }
+
+  if (isStreamLive()) {
+    stream::receiver()->read(inputValues, DMX_INPUT_START_SLOT, sizeof(inputValues));
+    return true;
+  }
+
+  if (DMX_INPUT_ENABLED && dmx::receiver()->isLive(millis())) {
+    dmx::receiver()->read(inputValues, DMX_INPUT_START_SLOT, sizeof(inputValues));
+    return true;
+  }
+
+  return false;
+}
+
+//a live console feed is merged with the pattern, which carries on underneath
+static void writeLeds(uint8_t *values, uint32_t length) {
+  if (readInput()) {
+    dmxMerge.merge(inputValues, values, inputValues, length);
+    values = inputValues;
+  }
+
+  outputFn(values, length);
 }
 
-static const led_strip_config_t CONFIG_LED_STRIP = {
+static uint32_t monotonicMs() {
+  return millis();
+}
+
+//how far in the past the frame being rendered was due, for frames the timer missed
+static uint32_t frameLagMs;
+
+//patterns run on the shared clock so units fed the same start time stay in phase
+static uint32_t sharedMs() {
+  return (uint32_t)clockSync.now(millis()) - frameLagMs;
+}
+
+//numLeds is the logical strip length, set once the pixel map is built
+static led_strip_config_t configLedStrip = {
   .numLeds = NUM_LEDS,
-  .writeValueFn = updateLedsDmx,
+  .writeValueFn = writeLeds,
+  .resolutionMs = TIMER_RESOLUTION_MS,
+  .timeFn = sharedMs,
+};
+
+static const frame_pacer_config_t CONFIG_FRAME_PACER = {
   .resolutionMs = TIMER_RESOLUTION_MS,
+  .policy = FRAME_OVERRUN_POLICY,
+  .intervalMaxMs = FRAME_INTERVAL_MAX_MS,
+  .recoverFrames = FRAME_RECOVER_FRAMES,
 };
 
+static Transition transition(&configLedStrip, outgoingValues);
+static FramePacer framePacer(&CONFIG_FRAME_PACER);
+static void (*tickFn)(uint32_t elapsedMs) = nullptr;
+static uint32_t lastTickMs;
+
+//where the pattern's time starts from, startTime is unix time or 0 for now
+static uint32_t patternEpoch(uint32_t startTime) {
+  const uint64_t nowMs = clockSync.now(millis());
+
+  if (!clockSync.isLocked()) {
+    return (uint32_t)nowMs;
+  }
+
+  if (startTime > 0) {
+    return (uint32_t)(startTime * 1000ULL);
+  }
+
+  return PHASE_SYNC_ENABLED ? (uint32_t)ClockSync::startOfDay(nowMs) : (uint32_t)nowMs;
+}
+
+//sample the reference as its seconds tick over, the PLL averages out the tick of latency
+static void syncClock() {
+  if (!Time.isValid() || (uint32_t)Time.now() == lastSyncSecond) {
+    return;
+  }
+
+  lastSyncSecond = Time.now();
+
+  if (clockSync.sample(millis(), lastSyncSecond * 1000ULL)) {
+    //the clock jumped, so the pattern's time no longer means anything
+    if (PHASE_SYNC_ENABLED) {
+      ledDriver->initState(&ledState);
+      ledState.timeMs = patternEpoch(0);
+    } else {
+      ledState.timeMs = sharedMs();
+    }
+
+    framePacer.wake(monotonicMs());
+  }
+}
+
+//the incoming pattern restarts from its first frame so there is no phase jump
+static void startPendingTransition() {
+  bool started = false;
+
+  WITH_LOCK(pendingLock) {
+    if (transitionPending) {
+      transition.begin(ledDriver, &ledState, ledValues, pendingDurationMs);
+      *ledDriver = *pendingDriver;
+      ledDriver->retainColours(liveColours);
+      ledDriver->initState(&ledState);
+      ledState.timeMs = patternEpoch(pendingStartTime);
+      transitionPending = false;
+      started = true;
+    }
+  }
+
+  if (started) {
+    framePacer.wake(monotonicMs());
+  }
+}
+
+//step the pattern through frames the timer missed without sending them, oldest first
+static void renderMissedFrames(uint32_t frames, uint32_t nowMs) {
+  const uint32_t first = frames - 1 > FRAME_MISSED_RENDER_MAX ? frames - 1 - FRAME_MISSED_RENDER_MAX : 0;
+
+  for (uint32_t i=first; i<frames-1; i++) {
+    frameLagMs = nowMs - framePacer.frameTime(i);
+    transition.skipFrame();
+    ledDriver->render(&ledState, ledValues);
+  }
+
+  frameLagMs = 0;
+}
+
+//the playlist and schedule see every tick, frames are only rendered when the pacer says so
 void ledStrip::onTimerFired() {
-  ledDriver->onTimerFired(&ledState, ledValues);
+  const uint32_t nowMs = monotonicMs();
+
+  //timer callbacks can be delayed, so hand on the time that actually passed
+  const uint32_t elapsedMs = nowMs - lastTickMs;
+
+  lastTickMs = nowMs;
+
+  syncClock();
+
+  if (tickFn != nullptr) {
+    tickFn(elapsedMs);
+  }
+
+  startPendingTransition();
+
+  //console input isn't held back by a pattern that isn't changing
+  if (isInputLive()) {
+    framePacer.wake(nowMs);
+  }
+
+  const uint32_t frames = framePacer.tick(nowMs);
+
+  if (frames == 0) {
+    return;
+  }
+
+  profiler::frameStart();
+
+  if (FRAME_OVERRUN_POLICY == overrunRenderMissed && frames > 1) {
+    renderMissedFrames(frames, nowMs);
+  }
+
+  transition.onTimerFired(ledDriver, &ledState, ledValues);
+
+  profiler::frameEnd(ledDriver->getPattern());
+  framePacer.frameDone(nowMs, monotonicMs());
+
+  //skip frames until the pattern next changes, but keep fades at the full rate and refresh
+  //often enough that DMX fixtures don't time out
+  const uint32_t waitMs = transition.isActive() ? 0 : ledDriver->nextChangeMs(&ledState);
+
+  framePacer.holdFor(waitMs < DMX_KEEPALIVE_MS ? waitMs : DMX_KEEPALIVE_MS);
+}
+
+const frame_stats_t* ledStrip::frameStats() {
+  return framePacer.stats();
+}
+
+void ledStrip::onTick(void (*fn)(uint32_t elapsedMs)) {
+  tickFn = fn;
+}
+
+//called from the cloud functions on either thread, the staged driver's colours are copied so they
+//can be replaced as soon as this returns
+void ledStrip::beginTransition(uint32_t durationMs, uint32_t startTime) {
+  WITH_LOCK(pendingLock) {
+    *pendingDriver = *stagedDriver;
+    pendingDriver->retainColours(pendingColours);
+    pendingDurationMs = durationMs;
+    pendingStartTime = startTime;
+    transitionPending = true;
+  }
 }
 
 void ledStrip::setup() {
-  dmx::setup();
+  if (DMX_INPUT_ENABLED) {
+    dmx::setupReceiver();
+  }
+
+  if (LED_OUTPUT == outputWs2812) {
+    ws2812::setup();
+  } else if (LED_OUTPUT == outputApa102) {
+    apa102::setup();
+  } else {
+    dmx::setup(&CONFIG_DMX_FRAME);
+  }
+
+  configLedStrip.numLeds = pixelMap::build(ledMap, &CONFIG_PIXEL_MAP);
 
-  ledDriver = new LedStripDriver((led_strip_config_t*)&CONFIG_LED_STRIP);
+  ledDriver = new LedStripDriver(&configLedStrip);
+  stagedDriver = new LedStripDriver(&configLedStrip);
+  pendingDriver = new LedStripDriver(&configLedStrip);
   ledDriver->initState(&ledState);
+  lastTickMs = monotonicMs();
+  framePacer.start(lastTickMs);
 
-  //default pattern on power-up
-  ledDriver->pattern(Pattern::pulse)
+  //default pattern on power-up, cut to on the first tick
+  stagedDriver->pattern(Pattern::pulse)
     ->period(2000)
     ->colourOn((Colour*)&COLOUR_START)
     ->colourOff((Colour*)&COLOUR_END);
+  beginTransition(0, 0);
 }
 
 LedStripDriver* ledStrip::getDriver() {
-  return ledDriver;
+  return stagedDriver;
 }
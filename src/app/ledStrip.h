@@ -1,12 +1,34 @@
 #ifndef OBELISK_LED_STRIP_H
 #define OBELISK_LED_STRIP_H
 
+#include "framePacer.h"
 #include "ledStripDriver.h"
 
+/* Where frames are sent */
+enum LedOutput {
+  outputDmx,    /* DMX fixtures on Serial1 */
+  outputWs2812, /* single wire addressable strip on the SPI port */
+  outputApa102  /* clocked addressable strip on the SPI port */
+};
+
 namespace ledStrip {
   void setup();
   void onTimerFired();
 
+  /*
+   * Crossfade from the current pattern to the next one configured on the driver, which starts
+   * from startTime (unix time, 0 = now) once the shared clock is locked. Safe to call from any
+   * thread, the render thread starts it on its next tick.
+   */
+  void beginTransition(uint32_t durationMs, uint32_t startTime);
+
+  /* Called on every timer tick, whether or not a frame is rendered, with the time since the last one */
+  void onTick(void (*fn)(uint32_t elapsedMs));
+
+  /* Frame counts for telemetry */
+  const frame_stats_t* frameStats();
+
+  /* Driver to configure the next pattern on, rendered from once beginTransition() is called */
   LedStripDriver* getDriver();
 }
 
@@ -3,9 +3,9 @@
 #include "colours.h"
 #include "config.h"
 
-const Colour COLOUR_DEFAULT = Colour(50, 0, 0);
-const Colour COL_BLACK = COLOUR_BLACK;
-const Colour COL_WHITE = COLOUR_WHITE;
+constexpr Colour COLOUR_DEFAULT = Colour(50, 0, 0);
+constexpr Colour COL_BLACK = COLOUR_BLACK;
+constexpr Colour COL_WHITE = COLOUR_WHITE;
 
 #define DUTY_DIR_INC 1
 #define DUTY_DIR_DEC -1
@@ -15,20 +15,41 @@ const Colour COL_WHITE = COLOUR_WHITE;
 uint8_t calcGradientColourValue(double gradient, double offset, uint32_t step);
 
 void LedStripDriver::initState(led_strip_state_t *state) {
+  state->timeMs = mConfig->timeFn != nullptr ? mConfig->timeFn() : 0;
   state->counter = 0;
-  state->dutyCycle = 1;
-  state->dutyDirection = DUTY_DIR_INC;
-  state->weatherTempFadeDirection = 1;
+  initPatternState(state);
+}
 
-  state->weatherRainCounter = 0;
-  state->weatherRainPosition = 0;
+void LedStripDriver::initPatternState(led_strip_state_t *state) {
+  state->pattern = mPattern;
 
-  state->weatherWarningCounter = 0;
-  state->weatherWarningFadeState = fadeIn;
+  switch(mPattern) {
+    case pulse:
+      state->pulse.direction = DUTY_DIR_INC;
+      break;
+
+    case progress:
+    case snake:
+      state->progress.step = 0;
+      break;
+
+    case weather:
+      state->weather.rainCounter = 0;
+      state->weather.warningCounter = 0;
+      state->weather.tempFadeDirection = 1;
+      state->weather.rainPosition = 0;
+      state->weather.warningFadeState = fadeIn;
+      break;
+
+    default:
+      break;
+  }
 }
 
 LedStripDriver::LedStripDriver(led_strip_config_t *config) {
   mConfig = config;
+  mFrameMs = config->resolutionMs;
+  mStepPending = false;
   mPeriodMs = 1000;
   mColourOn = (Colour*)&COLOUR_DEFAULT;
   mColourOff = (Colour*)&COL_BLACK;
@@ -59,10 +80,6 @@ LedStripDriver::LedStripDriver(led_strip_config_t *config) {
   mWeatherWarningOffDwellMs = 0;
 };
 
-inline void reverseDutyCycleDirection(led_strip_state_t *state) {
-  state->dutyDirection = -state->dutyDirection;
-}
-
 void writeColourValues(uint8_t *values, uint32_t numLeds, Colour *colour) {
   for (uint32_t i=0; i<numLeds; i++) {
       uint32_t index = i*3;
@@ -72,18 +89,6 @@ void writeColourValues(uint8_t *values, uint32_t numLeds, Colour *colour) {
     }
 }
 
-double calcDutyCycleIncrement(uint8_t dutyCycle, uint32_t pulsePeriod, uint32_t pwmPeriod) {
-  return (double)(100 * 100 / dutyCycle)/((double)pulsePeriod / pwmPeriod);
-}
-
-void updateDutyCycle(led_strip_state_t *state, double increment, double decrement) {
-  if (state->dutyDirection == DUTY_DIR_INC) {
-    state->dutyCycle += increment;
-  } else {
-    state->dutyCycle -= decrement;
-  }
-}
-
 void calculatePulseOffsets(double *offsets, Colour *startCol) {
   offsets[INDEX_RED] = startCol->getRed();
   offsets[INDEX_GREEN] = startCol->getGreen();
@@ -110,13 +115,16 @@ void LedStripDriver::handlePulsePattern(led_strip_state_t *state, uint8_t *value
   Colour *startCol, *endCol;
 
   if (state->counter >= mPeriodMs) {
-    state->counter = 0;
-    state->dutyDirection *= -1;
+    //an odd number of whole periods missed leaves the direction flipped
+    if (periods(state->counter, mPeriodMs) & 1) {
+      state->pulse.direction *= -1;
+    }
+    state->counter = carry(state->counter, mPeriodMs);
   }
 
   currentStep = state->counter / mConfig->resolutionMs;
 
-  if (state->dutyDirection > 0) {
+  if (state->pulse.direction > 0) {
     startCol = mColourOn;
     endCol = mColourOff;
   } else {
@@ -155,7 +163,7 @@ void LedStripDriver::handleBlinkPattern(led_strip_state_t *state, uint8_t *value
   Colour *colour;
 
   if (state->counter >= mPeriodMs) {
-    state->counter = 0;
+    state->counter = carry(state->counter, mPeriodMs);
   }
 
   if (state->counter < onTimeMs) {
@@ -176,7 +184,7 @@ void LedStripDriver::handleStrobePattern(led_strip_state_t *state, uint8_t *valu
   Colour *colour;
 
   if (state->counter >= mPeriodMs) {
-    state->counter = 0;
+    state->counter = carry(state->counter, mPeriodMs);
   }
 
   if (state->counter < onTimeMs) {
@@ -189,18 +197,41 @@ void LedStripDriver::handleStrobePattern(led_strip_state_t *state, uint8_t *valu
 }
 
 void LedStripDriver::handleProgressPattern(led_strip_state_t *state, uint8_t *values) {
-  uint32_t progressValue = mProgressInitial + state->progress;
+  uint32_t progressValue = mProgressInitial + state->progress.step;
   uint32_t ledsOn = (progressValue > mProgressFinal ? mProgressFinal : progressValue);
   uint32_t ledsOff = mConfig->numLeds - ledsOn;
 
-  if ((mProgressFinal - ledsOn) == 0) {
+  if (mConfig->timeFn != nullptr && mProgressIncrement > 0 && mProgressIncrementDelayMs > 0) {
+    //steps from the initial value until full, which holds for the reset delay as well
+    const uint32_t stepsToFull = mProgressFinal > mProgressInitial ?
+      (mProgressFinal - mProgressInitial + mProgressIncrement - 1) / mProgressIncrement : 0;
+    const uint32_t stepsTaken = state->progress.step / mProgressIncrement < stepsToFull ?
+      state->progress.step / mProgressIncrement : stepsToFull;
+    const uint32_t dueMs = stepsTaken < stepsToFull ?
+      mProgressIncrementDelayMs : mProgressIncrementDelayMs + mProgressResetDelayMs;
+
+    //a late frame takes every step it missed, wrapping round the cycle as many times as needed
+    if (state->counter >= dueMs) {
+      const uint32_t cycleMs = (stepsToFull + 1) * mProgressIncrementDelayMs + mProgressResetDelayMs;
+      const uint32_t cycleOffsetMs =
+        (stepsTaken * mProgressIncrementDelayMs + state->counter) % cycleMs;
+      const uint32_t steps = cycleOffsetMs / mProgressIncrementDelayMs < stepsToFull ?
+        cycleOffsetMs / mProgressIncrementDelayMs : stepsToFull;
+
+      state->progress.step = steps * mProgressIncrement;
+      state->counter = cycleOffsetMs - steps * mProgressIncrementDelayMs;
+      mStepPending = true;
+    }
+  } else if ((mProgressFinal - ledsOn) == 0) {
     if (state->counter >= (mProgressIncrementDelayMs + mProgressResetDelayMs)) {
-      state->counter = 0;
-      state->progress = 0;
+      state->counter = carry(state->counter, mProgressIncrementDelayMs + mProgressResetDelayMs);
+      state->progress.step = 0;
+      mStepPending = true;
     }
   } else if (state->counter >= mProgressIncrementDelayMs) {
-    state->progress += mProgressIncrement;
-    state->counter = 0;
+    state->progress.step += mProgressIncrement;
+    state->counter = carry(state->counter, mProgressIncrementDelayMs);
+    mStepPending = true;
   }
 
   if (mProgressDirection == Direction::forward) {
@@ -267,11 +298,11 @@ void LedStripDriver::handleSnakePattern(led_strip_state_t *state, uint8_t *value
   uint32_t end;
 
   if (mSnakeDirection == forward) {
-    start = mSnakeLength > state->progress ? 0 : state->progress - mSnakeLength;
-    end = state->progress;
+    start = mSnakeLength > state->progress.step ? 0 : state->progress.step - mSnakeLength;
+    end = state->progress.step;
   } else {
-    end = PROGRESS_MAX - state->progress;
-    start = state->progress < mConfig->numLeds ? (end - mSnakeLength): 0;
+    end = PROGRESS_MAX - state->progress.step;
+    start = state->progress.step < mConfig->numLeds ? (end - mSnakeLength): 0;
   }
 
 
@@ -284,12 +315,13 @@ void LedStripDriver::handleSnakePattern(led_strip_state_t *state, uint8_t *value
   }
 
   if (state->counter >= INCREMENT_MS) {
-    state->progress += 1;
-    state->counter = 0;
+    //catch up on any increments missed by late frames
+    const uint32_t increments = periods(state->counter, INCREMENT_MS);
 
-    if (state->progress >= PROGRESS_MAX) {
-      state->progress = 0;
-    }
+    state->progress.step = state->progress.step < PROGRESS_MAX ?
+                      (state->progress.step + increments % PROGRESS_MAX) % PROGRESS_MAX : 0;
+    state->counter = carry(state->counter, INCREMENT_MS);
+    mStepPending = true;
   }
 }
 
@@ -305,13 +337,16 @@ void LedStripDriver::handleWeatherPattern(led_strip_state_t *state, uint8_t *val
   double gradients[COLOURS_PER_LED];
 
   if (currentStep >= steps) {
-    state->counter = 0;
-    state->weatherTempFadeDirection *= -1;
+    //an odd number of whole fades missed leaves the direction flipped
+    if (periods(state->counter, steps * mConfig->resolutionMs) & 1) {
+      state->weather.tempFadeDirection *= -1;
+    }
+    state->counter = carry(state->counter, steps * mConfig->resolutionMs);
 
-    currentStep = 0;
+    currentStep = state->counter / mConfig->resolutionMs;
   }
 
-  if (state->weatherTempFadeDirection > 0) {
+  if (state->weather.tempFadeDirection > 0) {
     colourStart = mColourOn;
     colourEnd = mColourOff;
   } else {
@@ -345,20 +380,19 @@ void LedStripDriver::handleWeatherPattern(led_strip_state_t *state, uint8_t *val
   }
 
   // add rain bands
-  state->weatherRainCounter += mConfig->resolutionMs;
-  if (state->weatherRainCounter >= mWeatherRainBandIncDelayMs) {
-    state->weatherRainCounter = 0;
-    state->weatherRainPosition += 1;
+  state->weather.rainCounter += mFrameMs;
+  if (state->weather.rainCounter >= mWeatherRainBandIncDelayMs) {
+    const uint32_t increments = periods(state->weather.rainCounter, mWeatherRainBandIncDelayMs);
 
-    if (state->weatherRainPosition >= mConfig->numLeds) {
-      state->weatherRainPosition = 0;
-    }
+    state->weather.rainCounter = carry(state->weather.rainCounter, mWeatherRainBandIncDelayMs);
+    state->weather.rainPosition = state->weather.rainPosition < mConfig->numLeds ?
+      (state->weather.rainPosition + increments % mConfig->numLeds) % mConfig->numLeds : 0;
   }
 
   if (mWeatherRainBandHeightLeds > 0) {
     //get initial position with bands wrapping around
     uint32_t bandAndSpacingHeight = mWeatherRainBandHeightLeds + mWeatherRainBandSpacingLeds;
-    uint32_t rainInitialPosition = state->weatherRainPosition % bandAndSpacingHeight;
+    uint32_t rainInitialPosition = state->weather.rainPosition % bandAndSpacingHeight;
 
     if (mWeatherRainDirection == Direction::forward) {
       for (uint32_t i = rainInitialPosition; i < num_leds; i += bandAndSpacingHeight) {
@@ -384,38 +418,68 @@ void LedStripDriver::handleWeatherPattern(led_strip_state_t *state, uint8_t *val
     }
   }
 
-  state->weatherWarningCounter += mConfig->resolutionMs;
+  state->weather.warningCounter += mFrameMs;
 
-  switch(state->weatherWarningFadeState) {
-    case fadeIn:
-      if (state->weatherWarningCounter >= mWeatherWarningFadeInMs) {
-        state->weatherWarningCounter = 0;
-        state->weatherWarningFadeState = fadeOut;
-      }
-      break;
+  const uint32_t warningCycleMs =
+    mWeatherWarningFadeInMs + mWeatherWarningFadeOutMs + mWeatherWarningOffDwellMs;
 
-    case fadeOut:
-      if (state->weatherWarningCounter >= mWeatherWarningFadeOutMs) {
-        state->weatherWarningCounter = 0;
-        state->weatherWarningFadeState = offDwell;
-      }
-      break;
+  if (mConfig->timeFn != nullptr && warningCycleMs > 0) {
+    //place a late frame in the phase its time falls in, however many cycles it missed
+    uint32_t cycleOffsetMs = state->weather.warningCounter;
 
-    case offDwell:
-      if (state->weatherWarningCounter >= mWeatherWarningOffDwellMs) {
-        state->weatherWarningCounter = 0;
-        state->weatherWarningFadeState = fadeIn;
-      }
-      break;
+    if (state->weather.warningFadeState != fadeIn) {
+      cycleOffsetMs += mWeatherWarningFadeInMs;
+    }
+
+    if (state->weather.warningFadeState == offDwell) {
+      cycleOffsetMs += mWeatherWarningFadeOutMs;
+    }
+
+    cycleOffsetMs %= warningCycleMs;
+
+    if (cycleOffsetMs < mWeatherWarningFadeInMs) {
+      state->weather.warningFadeState = fadeIn;
+    } else if (cycleOffsetMs < mWeatherWarningFadeInMs + mWeatherWarningFadeOutMs) {
+      state->weather.warningFadeState = fadeOut;
+      cycleOffsetMs -= mWeatherWarningFadeInMs;
+    } else {
+      state->weather.warningFadeState = offDwell;
+      cycleOffsetMs -= mWeatherWarningFadeInMs + mWeatherWarningFadeOutMs;
+    }
+
+    state->weather.warningCounter = cycleOffsetMs;
+  } else {
+    switch(state->weather.warningFadeState) {
+      case fadeIn:
+        if (state->weather.warningCounter >= mWeatherWarningFadeInMs) {
+          state->weather.warningCounter = carry(state->weather.warningCounter, mWeatherWarningFadeInMs);
+          state->weather.warningFadeState = fadeOut;
+        }
+        break;
+
+      case fadeOut:
+        if (state->weather.warningCounter >= mWeatherWarningFadeOutMs) {
+          state->weather.warningCounter = carry(state->weather.warningCounter, mWeatherWarningFadeOutMs);
+          state->weather.warningFadeState = offDwell;
+        }
+        break;
+
+      case offDwell:
+        if (state->weather.warningCounter >= mWeatherWarningOffDwellMs) {
+          state->weather.warningCounter = carry(state->weather.warningCounter, mWeatherWarningOffDwellMs);
+          state->weather.warningFadeState = fadeIn;
+        }
+        break;
+    }
   }
 
   // weather warning
   if (mWeatherWarningFadeInMs > 0) {
     Colour warningColourStart = COLOUR_BLACK;
 
-    if (state->weatherWarningFadeState == fadeIn) {
+    if (state->weather.warningFadeState == fadeIn) {
       steps = mWeatherWarningFadeInMs / mConfig->resolutionMs;
-      currentStep = state->weatherWarningCounter / mConfig->resolutionMs;
+      currentStep = state->weather.warningCounter / mConfig->resolutionMs;
 
       offsets[INDEX_RED] = warningColourStart.getRed();
       offsets[INDEX_GREEN] = warningColourStart.getGreen();
@@ -428,9 +492,9 @@ void LedStripDriver::handleWeatherPattern(led_strip_state_t *state, uint8_t *val
       redVal = calcGradientColourValue(gradients[INDEX_RED], offsets[INDEX_RED], currentStep);
       greenVal = calcGradientColourValue(gradients[INDEX_GREEN], offsets[INDEX_GREEN], currentStep);
       blueVal = calcGradientColourValue(gradients[INDEX_BLUE], offsets[INDEX_BLUE], currentStep);
-    } else if (state->weatherWarningFadeState == fadeOut) {
+    } else if (state->weather.warningFadeState == fadeOut) {
       steps = mWeatherWarningFadeOutMs / mConfig->resolutionMs;
-      currentStep = state->weatherWarningCounter / mConfig->resolutionMs;
+      currentStep = state->weather.warningCounter / mConfig->resolutionMs;
 
       offsets[INDEX_RED] = mWeatherWarningColour->getRed();
       offsets[INDEX_GREEN] = mWeatherWarningColour->getGreen();
@@ -466,8 +530,46 @@ void LedStripDriver::handleWeatherPattern(led_strip_state_t *state, uint8_t *val
   }
 }
 
-void LedStripDriver::onTimerFired(led_strip_state_t *state, uint8_t *values) {
-  const uint32_t numLedValues = COLOURS_PER_LED * mConfig->numLeds;
+uint32_t LedStripDriver::periods(uint32_t counter, uint32_t periodMs) {
+  //unclocked the counter is reset as soon as it reaches the period, so only one has passed
+  if (mConfig->timeFn == nullptr || periodMs == 0) {
+    return 1;
+  }
+
+  return counter / periodMs;
+}
+
+uint32_t LedStripDriver::carry(uint32_t counter, uint32_t periodMs) {
+  //when clocked a late frame keeps whatever it overshot the period by, so the pattern stays in phase
+  if (mConfig->timeFn == nullptr || periodMs == 0) {
+    return 0;
+  }
+
+  return counter % periodMs;
+}
+
+void LedStripDriver::render(led_strip_state_t *state, uint8_t *values) {
+  const bool clocked = mConfig->timeFn != nullptr;
+
+  mStepPending = false;
+
+  //with a clock the frame is rendered at its actual time since the pattern started, so late
+  //frames catch up rather than stretching the pattern
+  if (clocked) {
+    const uint32_t nowMs = mConfig->timeFn();
+
+    //a start time still in the future holds the first frame
+    mFrameMs = (int32_t)(nowMs - state->timeMs) > 0 ? nowMs - state->timeMs : 0;
+    state->timeMs += mFrameMs;
+    state->counter += mFrameMs;
+  } else {
+    mFrameMs = mConfig->resolutionMs;
+  }
+
+  //the union still holds the previous pattern's state on the first frame after a change
+  if (state->pattern != mPattern) {
+    initPatternState(state);
+  }
 
   switch(mPattern) {
     case blink:
@@ -506,11 +608,77 @@ void LedStripDriver::onTimerFired(led_strip_state_t *state, uint8_t *values) {
       break;
   }
 
-  mConfig->writeValueFn(values, numLedValues);
+  if (!clocked) {
+    state->counter += mConfig->resolutionMs;
+  }
+}
+
+static uint32_t untilMs(uint32_t counter, uint32_t timeMs) {
+  return timeMs > counter ? timeMs - counter : 0;
+}
+
+uint32_t LedStripDriver::nextChangeMs(led_strip_state_t *state) {
+  //a step taken after drawing the frame shows on the next one
+  if (mStepPending) {
+    return 0;
+  }
+
+  switch(mPattern) {
+    case blink: {
+      const uint32_t onTimeMs = (uint32_t)((mPeriodMs * mDutyCycle) / 100);
+      return untilMs(state->counter, state->counter < onTimeMs ? onTimeMs : mPeriodMs);
+    }
+
+    case strobe: {
+      const uint32_t onTimeMs = (uint32_t)(mPeriodMs / 2);
+      return untilMs(state->counter, state->counter < onTimeMs ? onTimeMs : mPeriodMs);
+    }
+
+    case progress: {
+      const uint32_t progressValue = mProgressInitial + state->progress.step;
+
+      if (progressValue >= mProgressFinal) {
+        return untilMs(state->counter, mProgressIncrementDelayMs + mProgressResetDelayMs);
+      }
+
+      return untilMs(state->counter, mProgressIncrementDelayMs);
+    }
+
+    case snake:
+      return untilMs(state->counter, mPeriodMs / (mConfig->numLeds + mSnakeLength));
+
+    case colour:
+    case gradient:
+      return NEXT_CHANGE_NEVER;
 
-  state->counter += mConfig->resolutionMs;
+    //pulse and weather fade continuously
+    default:
+      return 0;
+  }
+}
+
+void LedStripDriver::onTimerFired(led_strip_state_t *state, uint8_t *values) {
+  const uint32_t numLedValues = COLOURS_PER_LED * mConfig->numLeds;
+
+  render(state, values);
+
+  mConfig->writeValueFn(values, numLedValues);
 };
 
+void LedStripDriver::retainColours(Colour *storage) {
+  Colour **colours[DRIVER_COLOUR_COUNT] = {
+    &mColourOn,
+    &mColourOff,
+    &mWeatherRainBandColour,
+    &mWeatherWarningColour,
+  };
+
+  for (uint32_t i=0; i < DRIVER_COLOUR_COUNT; i++) {
+    storage[i] = **colours[i];
+    *colours[i] = &storage[i];
+  }
+}
+
 LedStripDriver* LedStripDriver::period(uint32_t valueMs) {
   mPeriodMs = valueMs;
   return this;
@@ -3,7 +3,13 @@
 
 #include "colour.h"
 
-enum Pattern {
+/* Number of colours referenced by a driver, see retainColours() */
+#define DRIVER_COLOUR_COUNT 4
+
+/* Returned by nextChangeMs() for patterns that don't change */
+#define NEXT_CHANGE_NEVER 0xFFFFFFFF
+
+enum Pattern : uint8_t {
   blink,
   colour,
   gradient,
@@ -19,7 +25,7 @@ enum Direction {
   reverse
 };
 
-enum FadeState {
+enum FadeState : uint8_t {
   fadeIn,
   fadeOut,
   offDwell
@@ -29,26 +35,54 @@ typedef struct {
   uint32_t numLeds;
   void (*writeValueFn)(uint8_t *values, uint32_t length);
   uint32_t resolutionMs;
+
+  /*
+   * Optional monotonic clock (ms). Frames are rendered at the clock time since
+   * the pattern started, otherwise time advances by resolutionMs per frame.
+   */
+  uint32_t (*timeFn)();
 } led_strip_config_t;
 
 typedef struct {
+  uint32_t timeMs; /* clock time of the last frame, set ahead of the clock to delay the start */
   uint32_t counter;
 
-  int32_t dutyDirection;
-  double dutyCycle;
-
-  uint32_t progress;
-
-  int8_t weatherTempFadeDirection;
-  uint32_t weatherRainCounter;
-  uint8_t weatherRainPosition;
-  uint32_t weatherWarningCounter;
-  FadeState weatherWarningFadeState;
+  /*
+   * Only the active pattern's state is kept, the tag says which pattern that is
+   * so a pattern change reinitialises it on the next frame.
+   */
+  Pattern pattern;
+  union {
+    struct {
+      int8_t direction;
+    } pulse;
+
+    struct {
+      uint32_t step; /* progress and snake */
+    } progress;
+
+    struct {
+      uint32_t rainCounter;
+      uint32_t warningCounter;
+      int8_t tempFadeDirection;
+      uint8_t rainPosition;
+      FadeState warningFadeState;
+    } weather;
+  };
 } led_strip_state_t;
 
+static_assert(sizeof(led_strip_state_t) <= 24, "led_strip_state_t has outgrown its union");
+
 class LedStripDriver {
 private:
   led_strip_config_t* mConfig;
+  uint32_t mFrameMs; /* time advanced by the frame being rendered */
+  bool mStepPending; /* the last frame stepped the pattern after drawing it */
+
+  uint32_t carry(uint32_t counter, uint32_t periodMs);
+  uint32_t periods(uint32_t counter, uint32_t periodMs);
+
+  void initPatternState(led_strip_state_t *state);
 
   void handleBlinkPattern(led_strip_state_t *state, uint8_t *values);
   void handlePulsePattern(led_strip_state_t *state, uint8_t *values);
@@ -93,6 +127,22 @@ public:
   LedStripDriver(led_strip_config_t *config);
   void onTimerFired(led_strip_state_t *state, uint8_t *values);
 
+  /* Render the current pattern into values and advance state, without writing them out */
+  void render(led_strip_state_t *state, uint8_t *values);
+
+  /**
+   * Time from the last frame rendered until the pattern next looks different, so frames
+   * in between can be skipped
+   * @return 0 if it changes every frame, NEXT_CHANGE_NEVER if it is static
+   */
+  uint32_t nextChangeMs(led_strip_state_t *state);
+
+  /*
+   * Copy the referenced colours into storage (DRIVER_COLOUR_COUNT long) and use
+   * those copies, so the driver stays valid after the original colours are freed
+   */
+  void retainColours(Colour *storage);
+
   LedStripDriver* period(uint32_t valueMs);
   LedStripDriver* colourOn(Colour *colour);
   LedStripDriver* colourOff(Colour *colour);
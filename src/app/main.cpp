@@ -7,25 +7,182 @@
 #include "config.h"
 #include "events.h"
 #include "timers.h"
+#include "profiler.h"
+#include "dmx.h"
+#include "stream.h"
+#include "usbLink.h"
 
 //run user code on boot to drive status LED
 SYSTEM_MODE(SEMI_AUTOMATIC);
 
 static const String LOG_MODULE = "MAIN";
 
+static const uint32_t SERIAL_COMMANDS_MAX = 16;
+
 static CloudFunctions *cloudFunctions;
+static playlist_store_t playlistStore;
+static schedule_store_t scheduleStore;
+static volatile bool scheduleChanged;
+static_assert(EEPROM_ADDR_PLAYLIST + sizeof(playlist_store_t) <= EEPROM_ADDR_SCHEDULE, "the playlist overlaps the schedule in EEPROM");
+static uint32_t lastTimeSyncMs;
+static uint32_t lastTelemetryMs;
+static char telemetry[64];
+static char dmxInputTelemetry[64];
+static char streamTelemetry[64];
+static char dmxOutputTelemetry[DMX_STATS_SUMMARY_SIZE];
+
+typedef struct {
+  String name;
+  int (CloudFunctions::*fn)(String arg);
+} serial_command_t;
+
+//the cloud functions as registered, so the USB serial link runs the same ones
+static serial_command_t serialCommands[SERIAL_COMMANDS_MAX];
+static uint32_t serialCommandCount;
 
 int regFn(String name, int (CloudFunctions::*cloudFn)(String arg), CloudFunctions *cls) {
+  if (serialCommandCount < SERIAL_COMMANDS_MAX) {
+    serialCommands[serialCommandCount].name = name;
+    serialCommands[serialCommandCount].fn = cloudFn;
+    serialCommandCount++;
+  }
+
   return Particle.function(name, cloudFn, cls);
 }
 
+static int32_t runSerialCommand(const char *name, const char *args) {
+  for (uint32_t i=0; i<serialCommandCount; i++) {
+    if (serialCommands[i].name.equals(name)) {
+      return (cloudFunctions->*serialCommands[i].fn)(String(args));
+    }
+  }
+
+  return SERIAL_LINK_UNKNOWN_COMMAND;
+}
+
+static void savePlaylist(const playlist_store_t *store) {
+  EEPROM.put(EEPROM_ADDR_PLAYLIST, *store);
+}
+
+//entries fire on the render thread, so the schedule is only copied here and written from loop()
+static void saveSchedule(const schedule_store_t *store) {
+  scheduleStore = *store;
+  scheduleChanged = true;
+}
+
+static void writeSchedule() {
+  schedule_store_t store;
+
+  SINGLE_THREADED_BLOCK() {
+    store = scheduleStore;
+    scheduleChanged = false;
+  }
+
+  EEPROM.put(EEPROM_ADDR_SCHEDULE, store);
+}
+
+static uint32_t wallClockNow() {
+  return Time.isValid() ? Time.now() : 0;
+}
+
+static void onLedTick(uint32_t elapsedMs) {
+  cloudFunctions->onTick(elapsedMs);
+}
+
+//frames received, the frame rate, short, long and alternate start code frames and the slots in
+//the last frame, for the 'dmxIn' cloud variable
+static void updateDmxInputTelemetry() {
+  const dmx_receiver_stats_t *stats = dmx::receiver()->stats();
+
+  snprintf(dmxInputTelemetry, sizeof(dmxInputTelemetry), "%lu,%lu,%lu,%lu,%lu,%lu",
+           (unsigned long)stats->frames,
+           (unsigned long)(stats->intervalUs > 0 ? 1000000 / stats->intervalUs : 0),
+           (unsigned long)stats->shortFrames,
+           (unsigned long)stats->longFrames,
+           (unsigned long)stats->otherStartCodes,
+           (unsigned long)stats->slots);
+}
+
+//datagrams, frames for our universe, bad packets, other universes and out of order frames, for
+//the 'stream' cloud variable
+static void updateStreamTelemetry() {
+  const stream_stats_t *stats = stream::receiver()->stats();
+
+  snprintf(streamTelemetry, sizeof(streamTelemetry), "%lu,%lu,%lu,%lu,%lu",
+           (unsigned long)stats->packets,
+           (unsigned long)stats->frames,
+           (unsigned long)stats->badPackets,
+           (unsigned long)stats->otherUniverses,
+           (unsigned long)stats->outOfOrder);
+}
+
+//frames sent, overruns, frames missed, the frame interval and render thread deadline misses, for
+//the 'frames' cloud variable
+static void updateTelemetry() {
+  const frame_stats_t *stats = ledStrip::frameStats();
+
+  snprintf(telemetry, sizeof(telemetry), "%lu,%lu,%lu,%lu,%lu",
+           (unsigned long)stats->frames,
+           (unsigned long)stats->overruns,
+           (unsigned long)stats->missedFrames,
+           (unsigned long)stats->intervalMs,
+           (unsigned long)timers::deadlineMisses());
+
+  if (DMX_INPUT_ENABLED) {
+    updateDmxInputTelemetry();
+  }
+
+  if (STREAM_PROTOCOL != streamOff) {
+    updateStreamTelemetry();
+  }
+
+  //frames and bytes sent, the last frame's break, mark after break and slot times, time blocked per
+  //frame and in total, and the refresh rate, for the 'dmxOut' cloud variable and serial debug
+  if (LED_OUTPUT == outputDmx) {
+    dmx::transmitStats()->summary(dmxOutputTelemetry, sizeof(dmxOutputTelemetry));
+    serialDebugPrint("DMX", dmxOutputTelemetry);
+  }
+}
+
 void setup() {
   statusLed::setup();
   ledStrip::setup();
   events::setup();
+  profiler::setup();
   timers::setup();
 
   cloudFunctions = new CloudFunctions(ledStrip::getDriver(), &regFn);
+  cloudFunctions->onPatternChange(ledStrip::beginTransition)
+    ->onPlaylistChange(savePlaylist)
+    ->onScheduleChange(saveSchedule)
+    ->wallClock(wallClockNow);
+
+  //resume the playlist and schedule stored before power down, if there are any
+  EEPROM.get(EEPROM_ADDR_PLAYLIST, playlistStore);
+  cloudFunctions->loadPlaylist(&playlistStore);
+  EEPROM.get(EEPROM_ADDR_SCHEDULE, scheduleStore);
+  cloudFunctions->loadSchedule(&scheduleStore);
+
+  ledStrip::onTick(onLedTick);
+
+  if (SERIAL_LINK_ENABLED) {
+    usbLink::setup(runSerialCommand);
+  }
+
+  Particle.variable("frames", telemetry);
+
+  if (DMX_INPUT_ENABLED) {
+    Particle.variable("dmxIn", dmxInputTelemetry);
+  }
+
+  if (LED_OUTPUT == outputDmx) {
+    serialDebugSetup();
+    Particle.variable("dmxOut", dmxOutputTelemetry);
+  }
+
+  if (STREAM_PROTOCOL != streamOff) {
+    Particle.variable("stream", streamTelemetry);
+  }
 
   Particle.connect();
 }
@@ -36,4 +193,28 @@ void setup() {
  * so arbitrarily long delays can safely be done if you need them.
  */
 void loop() {
+  //keep the reference for the shared pattern clock fresh, it is only set on connect otherwise
+  if (Particle.connected() && millis() - lastTimeSyncMs > TIME_SYNC_INTERVAL_MS) {
+    Particle.syncTime();
+    lastTimeSyncMs = millis();
+  }
+
+  if (scheduleChanged) {
+    writeSchedule();
+  }
+
+  if (millis() - lastTelemetryMs > TELEMETRY_INTERVAL_MS) {
+    updateTelemetry();
+    lastTelemetryMs = millis();
+  }
+
+  if (STREAM_PROTOCOL != streamOff) {
+    stream::poll();
+  }
+
+  if (SERIAL_LINK_ENABLED) {
+    usbLink::poll();
+  }
+
+  profiler::report();
 }
@@ -0,0 +1,98 @@
+#include "pixelMap.h"
+#include "config.h"
+
+namespace pixelMap {
+  static uint32_t unzig(uint32_t index, uint32_t width, uint32_t numLeds) {
+    uint32_t row = index / width;
+    uint32_t col = index % width;
+
+    if (row % 2 == 1) {
+      //last row may be partially populated
+      uint32_t rowLength = numLeds - row * width;
+
+      if (rowLength > width) {
+        rowLength = width;
+      }
+
+      col = rowLength - 1 - col;
+    }
+
+    return row * width + col;
+  }
+
+  uint32_t build(uint16_t *map, const pixel_map_config_t *config) {
+    const uint32_t numLeds = config->numLeds;
+    uint32_t logicalLeds = numLeds;
+
+    if (config->mirror) {
+      logicalLeds = (numLeds + 1) / 2;
+    }
+
+    if (config->repeat > 0 && config->repeat < logicalLeds) {
+      logicalLeds = config->repeat;
+    }
+
+    for (uint32_t i=0; i < numLeds; i++) {
+      uint32_t index = (i + numLeds - (config->offset % numLeds)) % numLeds;
+
+      if (config->reverse) {
+        index = numLeds - 1 - index;
+      }
+
+      if (config->serpentineWidth > 0) {
+        index = unzig(index, config->serpentineWidth, numLeds);
+      }
+
+      if (config->mirror && index >= (numLeds + 1) / 2) {
+        index = numLeds - 1 - index;
+      }
+
+      map[i] = (uint16_t)(index % logicalLeds);
+    }
+
+    return logicalLeds;
+  }
+
+  //R, G and B are the output positions of each channel, fixed per kernel so the loop doesn't branch
+  template <uint8_t R, uint8_t G, uint8_t B>
+  static void gather(uint8_t *output, const uint8_t *values, const uint16_t *map, uint32_t numLeds) {
+    for (uint32_t i=0; i < numLeds; i++) {
+      const uint8_t *src = &values[map[i] * COLOURS_PER_LED];
+      uint8_t *dst = &output[i * COLOURS_PER_LED];
+
+      dst[R] = src[INDEX_RED];
+      dst[G] = src[INDEX_GREEN];
+      dst[B] = src[INDEX_BLUE];
+    }
+  }
+
+  void apply(uint8_t *output, const uint8_t *values, const uint16_t *map, uint32_t numLeds,
+             ColourOrder order) {
+    switch (order) {
+      case orderRbg:
+        gather<0, 2, 1>(output, values, map, numLeds);
+        break;
+
+      case orderGrb:
+        gather<1, 0, 2>(output, values, map, numLeds);
+        break;
+
+      case orderGbr:
+        gather<2, 0, 1>(output, values, map, numLeds);
+        break;
+
+      case orderBrg:
+        gather<1, 2, 0>(output, values, map, numLeds);
+        break;
+
+      case orderBgr:
+        gather<2, 1, 0>(output, values, map, numLeds);
+        break;
+
+      case orderRgb:
+      default:
+        gather<0, 1, 2>(output, values, map, numLeds);
+        break;
+    }
+  }
+}
@@ -0,0 +1,53 @@
+#ifndef OBELISK_PIXEL_MAP_H
+#define OBELISK_PIXEL_MAP_H
+
+#include "Particle.h"
+
+/* Order an output expects the channels of each LED in, patterns always render RGB */
+enum ColourOrder : uint8_t {
+  orderRgb,
+  orderRbg,
+  orderGrb,
+  orderGbr,
+  orderBrg,
+  orderBgr,
+};
+
+/*
+ * Describes how the logical LEDs rendered by the patterns are laid out on the
+ * physical strip. Transforms are applied to each physical LED in order:
+ * offset, reverse, serpentine, mirror, repeat.
+ */
+typedef struct {
+  uint32_t numLeds;         /* physical LEDs on the output */
+  uint32_t offset;          /* physical LED showing the first logical LED */
+  bool reverse;             /* first logical LED at the far end of the strip */
+  uint32_t serpentineWidth; /* LEDs per row of a zig-zag panel, 0 = straight strip */
+  bool mirror;              /* second half of the strip reflects the first */
+  uint32_t repeat;          /* logical segment length repeated along the strip, 0 = off */
+  ColourOrder colourOrder;  /* channel order of the fixtures on the output */
+} pixel_map_config_t;
+
+namespace pixelMap {
+  /**
+   * Build the physical to logical LED lookup table
+   * @param map output table, must hold config->numLeds entries
+   * @param config layout of the physical strip
+   * @return number of logical LEDs the patterns should render
+   */
+  uint32_t build(uint16_t *map, const pixel_map_config_t *config);
+
+  /**
+   * Gather logical LED values into physical order and the output's channel order
+   * in a single pass
+   * @param output physical LED values, numLeds * COLOURS_PER_LED long
+   * @param values logical LED values rendered by the patterns
+   * @param map lookup table created by build()
+   * @param numLeds number of physical LEDs
+   * @param order channel order of the output
+   */
+  void apply(uint8_t *output, const uint8_t *values, const uint16_t *map, uint32_t numLeds,
+             ColourOrder order = orderRgb);
+}
+
+#endif
@@ -0,0 +1,137 @@
+#include "playlist.h"
+
+#define ENTRY_HEADER_SIZE 7
+
+static void writeUint(uint8_t *output, uint32_t value, uint32_t size) {
+  for (uint32_t i=0; i<size; i++) {
+    output[i] = (uint8_t)(value >> (8 * i));
+  }
+}
+
+static uint32_t readUint(const uint8_t *input, uint32_t size) {
+  uint32_t value = 0;
+
+  for (uint32_t i=0; i<size; i++) {
+    value |= (uint32_t)input[i] << (8 * i);
+  }
+
+  return value;
+}
+
+//the entry header and the command's packed arguments
+static uint32_t entrySize(const argParser::ArgConfig *config) {
+  uint32_t size = ENTRY_HEADER_SIZE;
+
+  for (uint32_t i=0; i<config->length; i++) {
+    size += argParser::packedSize(&config->info[i]);
+  }
+
+  return size;
+}
+
+Playlist::Playlist(playlist_store_t *store) {
+  mStore = store;
+  mIndex = 0;
+  mElapsedMs = 0;
+  mRunning = false;
+  mPending = false;
+}
+
+void Playlist::clear() {
+  mStore->magic = PLAYLIST_MAGIC;
+  mStore->count = 0;
+  mStore->used = 0;
+
+  stop();
+}
+
+bool Playlist::add(uint8_t command,
+                   const argParser::ArgConfig *config,
+                   const uint32_t *values,
+                   uint32_t durationMs,
+                   uint32_t transitionMs) {
+  const uint32_t size = entrySize(config);
+  uint8_t *entry = &mStore->pool[mStore->used];
+
+  if (mStore->count >= PLAYLIST_ENTRIES_MAX || (mStore->used + size) > PLAYLIST_POOL_SIZE) {
+    return false;
+  }
+
+  entry[0] = command;
+  writeUint(&entry[1], durationMs, 4);
+  writeUint(&entry[5], transitionMs, 2);
+  argParser::packArgs(&entry[ENTRY_HEADER_SIZE], config, values);
+
+  mStore->offsets[mStore->count] = mStore->used;
+  mStore->count += 1;
+  mStore->used += size;
+
+  return true;
+}
+
+bool Playlist::isValid() {
+  if (mStore->magic != PLAYLIST_MAGIC ||
+      mStore->count > PLAYLIST_ENTRIES_MAX ||
+      mStore->used > PLAYLIST_POOL_SIZE) {
+    return false;
+  }
+
+  for (uint32_t i=0; i<mStore->count; i++) {
+    if ((mStore->offsets[i] + ENTRY_HEADER_SIZE) > mStore->used) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool Playlist::entryFits(uint32_t index, const argParser::ArgConfig *config) {
+  return (mStore->offsets[index] + entrySize(config)) <= mStore->used;
+}
+
+void Playlist::entry(uint32_t index, playlist_entry_t *entry) {
+  const uint8_t *data = &mStore->pool[mStore->offsets[index]];
+
+  entry->command = data[0];
+  entry->durationMs = readUint(&data[1], 4);
+  entry->transitionMs = readUint(&data[5], 2);
+  entry->args = &data[ENTRY_HEADER_SIZE];
+}
+
+void Playlist::start() {
+  mIndex = 0;
+  mElapsedMs = 0;
+  mRunning = mStore->count > 0;
+  mPending = mRunning;
+}
+
+void Playlist::stop() {
+  mRunning = false;
+  mPending = false;
+}
+
+int32_t Playlist::tick(uint32_t elapsedMs) {
+  playlist_entry_t current;
+
+  if (!mRunning) {
+    return -1;
+  }
+
+  if (mPending) {
+    mPending = false;
+    return mIndex;
+  }
+
+  entry(mIndex, &current);
+  mElapsedMs += elapsedMs;
+
+  if (mElapsedMs < current.durationMs) {
+    return -1;
+  }
+
+  //keep any overshoot so the playlist does not drift
+  mElapsedMs -= current.durationMs;
+  mIndex = (mIndex + 1) % mStore->count;
+
+  return mIndex;
+}
@@ -0,0 +1,83 @@
+#ifndef OBELISK_PLAYLIST_H
+#define OBELISK_PLAYLIST_H
+
+#include "Particle.h"
+#include "argParser.h"
+
+#define PLAYLIST_ENTRIES_MAX 16
+#define PLAYLIST_POOL_SIZE 256
+
+/* Bump the version if the entry layout or command numbering changes */
+#define PLAYLIST_MAGIC 0x5001
+
+/*
+ * Playlist entries packed back to back in the pool, each an entry header
+ * followed by its arguments packed by argParser::packArgs(). The struct is
+ * stored in EEPROM as is.
+ */
+typedef struct {
+  uint16_t magic;
+  uint16_t count;
+  uint16_t used;
+  uint16_t offsets[PLAYLIST_ENTRIES_MAX];
+  uint8_t pool[PLAYLIST_POOL_SIZE];
+} playlist_store_t;
+
+typedef struct {
+  uint8_t command;
+  uint32_t durationMs;
+  uint32_t transitionMs;
+  const uint8_t *args; /* packed arguments, see argParser::unpackArgs() */
+} playlist_entry_t;
+
+class Playlist {
+private:
+  playlist_store_t *mStore;
+  uint32_t mIndex;
+  uint32_t mElapsedMs;
+  bool mRunning;
+  bool mPending;
+
+public:
+  Playlist(playlist_store_t *store);
+
+  /* Remove all entries and stop playing */
+  void clear();
+
+  /**
+   * Append an entry
+   * @return false if the playlist is full
+   */
+  bool add(uint8_t command,
+           const argParser::ArgConfig *config,
+           const uint32_t *values,
+           uint32_t durationMs,
+           uint32_t transitionMs);
+
+  /* True if the store holds a well formed playlist, eg after loading from EEPROM */
+  bool isValid();
+
+  /**
+   * True if an entry's arguments, packed for its command's config, end within the pool's used
+   * bytes. isValid() only checks the entry headers, as the command's config isn't known here.
+   */
+  bool entryFits(uint32_t index, const argParser::ArgConfig *config);
+
+  uint32_t length() { return mStore->count; };
+  bool isRunning() { return mRunning; };
+
+  void entry(uint32_t index, playlist_entry_t *entry);
+
+  /* Play from the first entry, which is entered on the next tick */
+  void start();
+  void stop();
+
+  /**
+   * Advance the playlist
+   * @param elapsedMs time since the last tick
+   * @return index of the entry to enter, or -1 to keep the current pattern
+   */
+  int32_t tick(uint32_t elapsedMs);
+};
+
+#endif
@@ -0,0 +1,213 @@
+#include "profiler.h"
+#include "serialDebug.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifndef PLATFORM_ID
+  #include <chrono>
+#endif
+
+#define BIN_COUNT_MAX 0xFFFF
+
+//names in the order of the Pattern enum
+static const char *PATTERN_NAMES[PROFILE_PATTERN_COUNT] = {
+  "blink",
+  "colour",
+  "gradient",
+  "progress",
+  "pulse",
+  "snake",
+  "strobe",
+  "weather",
+};
+
+Log2Histogram::Log2Histogram() {
+  clear();
+}
+
+void Log2Histogram::clear() {
+  memset(mBins, 0, sizeof(mBins));
+  mMax = 0;
+}
+
+uint32_t Log2Histogram::binOf(uint32_t value) {
+  uint32_t bin = 0;
+
+  while (value > 0 && bin < HISTOGRAM_BINS - 1) {
+    value >>= 1;
+    bin++;
+  }
+
+  return bin;
+}
+
+void Log2Histogram::add(uint32_t value) {
+  const uint32_t bin = binOf(value);
+
+  if (mBins[bin] == BIN_COUNT_MAX) {
+    for (uint32_t i=0; i<HISTOGRAM_BINS; i++) {
+      mBins[i] >>= 1;
+    }
+  }
+
+  mBins[bin]++;
+  mMax = value > mMax ? value : mMax;
+}
+
+uint32_t Log2Histogram::count() {
+  uint32_t total = 0;
+
+  for (uint32_t i=0; i<HISTOGRAM_BINS; i++) {
+    total += mBins[i];
+  }
+
+  return total;
+}
+
+uint32_t Log2Histogram::percentile(uint32_t percent) {
+  const uint32_t total = count();
+  //rank of the sample at the percentile, rounded up
+  const uint32_t rank = (total * percent + 99) / 100;
+  uint32_t seen = 0;
+
+  if (total == 0) {
+    return 0;
+  }
+
+  for (uint32_t i=0; i<HISTOGRAM_BINS; i++) {
+    seen += mBins[i];
+
+    if (seen >= rank && seen > 0) {
+      return i == HISTOGRAM_BINS - 1 ? mMax : (1UL << i);
+    }
+  }
+
+  return mMax;
+}
+
+RenderProfile::RenderProfile() {
+  mFrameStart = 0;
+  mWriteStart = 0;
+  mWriteCycles = 0;
+}
+
+void RenderProfile::frameStart(uint32_t cycles) {
+  mFrameStart = cycles;
+  mWriteCycles = 0;
+}
+
+void RenderProfile::writeStart(uint32_t cycles) {
+  mWriteStart = cycles;
+}
+
+void RenderProfile::writeEnd(uint32_t cycles) {
+  mWriteCycles += cycles - mWriteStart;
+}
+
+//rendering is whatever the frame spent outside of writing the values
+void RenderProfile::frameEnd(uint32_t pattern, uint32_t cycles) {
+  const uint32_t frameCycles = cycles - mFrameStart;
+
+  if (pattern >= PROFILE_PATTERN_COUNT) {
+    return;
+  }
+
+  mRender[pattern].add((frameCycles - mWriteCycles) / CYCLES_PER_US);
+  mWrite[pattern].add(mWriteCycles / CYCLES_PER_US);
+}
+
+uint32_t RenderProfile::summary(char *output, uint32_t size) {
+  uint32_t length = 0;
+
+  output[0] = '\0';
+
+  for (uint32_t i=0; i<PROFILE_PATTERN_COUNT; i++) {
+    Log2Histogram *render = &mRender[i];
+    Log2Histogram *write = &mWrite[i];
+    int32_t written;
+
+    if (render->count() == 0) {
+      continue;
+    }
+
+    written = snprintf(&output[length], size - length, "%s:r%lu,%lu,%luw%lu,%lu,%lu ",
+                       PATTERN_NAMES[i],
+                       (unsigned long)render->percentile(50),
+                       (unsigned long)render->percentile(99),
+                       (unsigned long)render->max(),
+                       (unsigned long)write->percentile(50),
+                       (unsigned long)write->percentile(99),
+                       (unsigned long)write->max());
+
+    //drop a pattern that doesn't fit rather than leave half of it
+    if (written < 0 || (uint32_t)written >= size - length) {
+      output[length] = '\0';
+      break;
+    }
+
+    length += written;
+  }
+
+  return length;
+}
+
+#ifdef PLATFORM_ID
+void cycleCounter::enable() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t cycleCounter::now() {
+  return DWT->CYCCNT;
+}
+#else
+//host builds count the same rate of cycles from the steady clock
+void cycleCounter::enable() {
+}
+
+uint32_t cycleCounter::now() {
+  const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+  const uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count();
+
+  return (uint32_t)(us * CYCLES_PER_US);
+}
+#endif
+
+#ifdef RENDER_PROFILING
+static RenderProfile renderProfile;
+static char summary[PROFILE_SUMMARY_SIZE];
+static uint32_t lastReportMs;
+
+void profiler::setup() {
+  cycleCounter::enable();
+  serialDebugSetup();
+  Particle.variable("profile", summary);
+}
+
+void profiler::frameStart() {
+  renderProfile.frameStart(cycleCounter::now());
+}
+
+void profiler::writeStart() {
+  renderProfile.writeStart(cycleCounter::now());
+}
+
+void profiler::writeEnd() {
+  renderProfile.writeEnd(cycleCounter::now());
+}
+
+void profiler::frameEnd(uint32_t pattern) {
+  renderProfile.frameEnd(pattern, cycleCounter::now());
+}
+
+void profiler::report() {
+  if (millis() - lastReportMs < PROFILE_REPORT_INTERVAL_MS) {
+    return;
+  }
+
+  lastReportMs = millis();
+  renderProfile.summary(summary, sizeof(summary));
+  serialDebugPrint("PROFILE", summary);
+}
+#endif
@@ -0,0 +1,100 @@
+#ifndef OBELISK_PROFILER_H
+#define OBELISK_PROFILER_H
+
+#include "Particle.h"
+#include "config.h"
+#include "ledStripDriver.h"
+
+#define HISTOGRAM_BINS 18
+#define CYCLES_PER_US 120 /* STM32F205 core clock */
+#define PROFILE_PATTERN_COUNT (Pattern::weather + 1)
+#define PROFILE_SUMMARY_SIZE 240 /* fits a serial debug line, see LOG_SIZE_MAX */
+
+/*
+ * Counts of values by power of two, bin n holds values below 2^n down to 2^(n-1)
+ * and the last bin everything above. Counts are halved when one fills up so
+ * the shape of the distribution is kept.
+ */
+class Log2Histogram {
+private:
+  uint16_t mBins[HISTOGRAM_BINS];
+  uint32_t mMax;
+
+public:
+  Log2Histogram();
+
+  void clear();
+  void add(uint32_t value);
+
+  uint32_t count();
+  uint32_t max() { return mMax; };
+  uint16_t bin(uint32_t index) { return mBins[index]; };
+
+  /* Upper bound of the bin holding the given percentile, 0 if empty */
+  uint32_t percentile(uint32_t percent);
+
+  static uint32_t binOf(uint32_t value);
+};
+
+/*
+ * Time spent on each frame per pattern, split into rendering and writing the
+ * values out.  Timestamps are in cycles, the histograms in us.
+ */
+class RenderProfile {
+private:
+  Log2Histogram mRender[PROFILE_PATTERN_COUNT];
+  Log2Histogram mWrite[PROFILE_PATTERN_COUNT];
+  uint32_t mFrameStart;
+  uint32_t mWriteStart;
+  uint32_t mWriteCycles;
+
+public:
+  RenderProfile();
+
+  void frameStart(uint32_t cycles);
+  void writeStart(uint32_t cycles);
+  void writeEnd(uint32_t cycles);
+  void frameEnd(uint32_t pattern, uint32_t cycles);
+
+  Log2Histogram* render(uint32_t pattern) { return &mRender[pattern]; };
+  Log2Histogram* write(uint32_t pattern) { return &mWrite[pattern]; };
+
+  /**
+   * Patterns with frames recorded as '<pattern>:r<p50>,<p99>,<max>w<p50>,<p99>,<max> ' in us
+   * @return number of characters written, excluding the terminator
+   */
+  uint32_t summary(char *output, uint32_t size);
+};
+
+namespace cycleCounter {
+  void enable();
+
+  /* Free running, wraps every ~35s */
+  uint32_t now();
+}
+
+/*
+ * Render loop instrumentation, enabled with RENDER_PROFILING. When disabled the
+ * calls are empty inline functions so they compile to nothing.
+ */
+namespace profiler {
+#ifdef RENDER_PROFILING
+  void setup();
+  void frameStart();
+  void writeStart();
+  void writeEnd();
+  void frameEnd(uint32_t pattern);
+
+  /* Publish the summary to the cloud variable and serial debug, call from the main loop */
+  void report();
+#else
+  inline void setup() {}
+  inline void frameStart() {}
+  inline void writeStart() {}
+  inline void writeEnd() {}
+  inline void frameEnd(uint32_t pattern) {}
+  inline void report() {}
+#endif
+}
+
+#endif
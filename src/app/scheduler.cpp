@@ -0,0 +1,127 @@
+#include "scheduler.h"
+
+Scheduler::Scheduler() {
+  clear();
+}
+
+void Scheduler::clear() {
+  mStore.magic = SCHEDULE_MAGIC;
+  mStore.count = 0;
+}
+
+bool Scheduler::load(const schedule_store_t *store) {
+  if (store->magic != SCHEDULE_MAGIC || store->count > SCHEDULE_ENTRIES_MAX) {
+    clear();
+    return false;
+  }
+
+  mStore = *store;
+
+  //restore the heap order in case the store was written by hand
+  for (uint32_t i=mStore.count / 2; i > 0; i--) {
+    siftDown(i - 1);
+  }
+
+  return true;
+}
+
+void Scheduler::swap(uint32_t a, uint32_t b) {
+  schedule_entry_t tmp = mStore.entries[a];
+  mStore.entries[a] = mStore.entries[b];
+  mStore.entries[b] = tmp;
+}
+
+void Scheduler::siftUp(uint32_t index) {
+  while (index > 0) {
+    uint32_t parent = (index - 1) / 2;
+
+    if (mStore.entries[parent].time <= mStore.entries[index].time) {
+      break;
+    }
+
+    swap(parent, index);
+    index = parent;
+  }
+}
+
+void Scheduler::siftDown(uint32_t index) {
+  for (;;) {
+    uint32_t smallest = index;
+    uint32_t left = 2 * index + 1;
+    uint32_t right = left + 1;
+
+    if (left < mStore.count && mStore.entries[left].time < mStore.entries[smallest].time) {
+      smallest = left;
+    }
+
+    if (right < mStore.count && mStore.entries[right].time < mStore.entries[smallest].time) {
+      smallest = right;
+    }
+
+    if (smallest == index) {
+      break;
+    }
+
+    swap(smallest, index);
+    index = smallest;
+  }
+}
+
+bool Scheduler::add(uint8_t command,
+                    const argParser::ArgConfig *config,
+                    const uint32_t *values,
+                    uint32_t time,
+                    uint32_t repeatSecs) {
+  uint32_t size = 0;
+  schedule_entry_t *entry = &mStore.entries[mStore.count];
+
+  for (uint32_t i=0; i<config->length; i++) {
+    size += argParser::packedSize(&config->info[i]);
+  }
+
+  if (mStore.count >= SCHEDULE_ENTRIES_MAX || size > SCHEDULE_ARGS_SIZE) {
+    return false;
+  }
+
+  entry->time = time;
+  entry->repeatSecs = repeatSecs;
+  entry->command = command;
+  argParser::packArgs(entry->args, config, values);
+
+  mStore.count += 1;
+  siftUp(mStore.count - 1);
+
+  return true;
+}
+
+bool Scheduler::next(uint32_t now, schedule_entry_t *entry) {
+  schedule_entry_t *top = &mStore.entries[0];
+
+  if (mStore.count == 0 || top->time > now) {
+    return false;
+  }
+
+  *entry = *top;
+
+  if (top->repeatSecs > 0) {
+    //skip any repeats missed while the clock was behind
+    top->time += ((now - top->time) / top->repeatSecs + 1) * top->repeatSecs;
+  } else {
+    mStore.count -= 1;
+    *top = mStore.entries[mStore.count];
+  }
+
+  siftDown(0);
+
+  return true;
+}
+
+uint32_t Scheduler::nextDailyTime(uint32_t now, uint32_t secondOfDay) {
+  uint32_t time = now - (now % SECONDS_PER_DAY) + secondOfDay;
+
+  if (time <= now) {
+    time += SECONDS_PER_DAY;
+  }
+
+  return time;
+}
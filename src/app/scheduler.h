@@ -0,0 +1,81 @@
+#ifndef OBELISK_SCHEDULER_H
+#define OBELISK_SCHEDULER_H
+
+#include "Particle.h"
+#include "argParser.h"
+
+#define SCHEDULE_ENTRIES_MAX 16
+#define SCHEDULE_ARGS_SIZE 24
+
+#define SECONDS_PER_DAY 86400
+
+/* Bump the version if the entry layout or command numbering changes */
+#define SCHEDULE_MAGIC 0x5C01
+
+typedef struct {
+  uint32_t time;       /* unix time the entry is next due */
+  uint32_t repeatSecs; /* 0 = fire once */
+  uint8_t command;
+  uint8_t args[SCHEDULE_ARGS_SIZE]; /* packed arguments, see argParser::unpackArgs() */
+} schedule_entry_t;
+
+/* Entries in heap order, stored in EEPROM as is */
+typedef struct {
+  uint16_t magic;
+  uint16_t count;
+  schedule_entry_t entries[SCHEDULE_ENTRIES_MAX];
+} schedule_store_t;
+
+/*
+ * Commands scheduled against wall clock time. Entries are kept in a binary
+ * min-heap on their due time, so checking for a due entry on every tick only
+ * looks at the top of the heap.
+ */
+class Scheduler {
+private:
+  schedule_store_t mStore;
+
+  void siftUp(uint32_t index);
+  void siftDown(uint32_t index);
+  void swap(uint32_t a, uint32_t b);
+
+public:
+  Scheduler();
+
+  void clear();
+
+  /**
+   * Schedule a command
+   * @param time unix time to fire at
+   * @param repeatSecs interval to fire again after, 0 = once
+   * @return false if the schedule is full or the arguments don't fit
+   */
+  bool add(uint8_t command,
+           const argParser::ArgConfig *config,
+           const uint32_t *values,
+           uint32_t time,
+           uint32_t repeatSecs);
+
+  /**
+   * Take the next entry due at or before now. Repeating entries are rescheduled
+   * to their next time after now, entries missed in the meantime are skipped.
+   * @return false if no entry is due
+   */
+  bool next(uint32_t now, schedule_entry_t *entry);
+
+  uint32_t length() { return mStore.count; };
+
+  /* The entries to persist, restored with load() */
+  const schedule_store_t* store() { return &mStore; };
+
+  /**
+   * Restore entries saved from store(), eg after loading from EEPROM
+   * @return false if the store isn't a well formed schedule, which leaves it empty
+   */
+  bool load(const schedule_store_t *store);
+
+  /* First time after now that is secondOfDay seconds past midnight (UTC) */
+  static uint32_t nextDailyTime(uint32_t now, uint32_t secondOfDay);
+};
+
+#endif
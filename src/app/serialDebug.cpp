@@ -1,13 +1,23 @@
 #include "serialDebug.h"
+#include "config.h"
 #include <stdio.h>
 
+//with the serial link on, USB serial carries its binary frames, text would corrupt them
 void serialDebugSetup() {
+  if (SERIAL_LINK_ENABLED) {
+    return;
+  }
+
   Serial.begin(115200);
 }
 
 void serialDebugPrint(String module, String message) {
   char s[LOG_SIZE_MAX];
 
+  if (SERIAL_LINK_ENABLED) {
+    return;
+  }
+
   sprintf(s, "[%s]: %s", module.c_str(), message.c_str());
 
   Serial.println(s);
@@ -0,0 +1,192 @@
+#include "serialLink.h"
+#include <atomic>
+#include <string.h>
+
+static const uint8_t SYNC_0 = 0xA5;
+static const uint8_t SYNC_1 = 0x5A;
+static const uint16_t CRC_INIT = 0xFFFF;
+
+//CRC-16/CCITT-FALSE (polynomial 0x1021) of each nibble, two lookups a byte from a 32 byte table
+static const uint16_t CRC_NIBBLE[] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+static inline uint16_t crcUpdate(uint16_t crc, uint8_t byte) {
+  crc = (crc << 4) ^ CRC_NIBBLE[(crc >> 12) ^ (byte >> 4)];
+  crc = (crc << 4) ^ CRC_NIBBLE[(crc >> 12) ^ (byte & 0x0F)];
+  return crc;
+}
+
+SerialLink::SerialLink(int32_t (*commandFn)(const char *name, const char *args), uint32_t timeoutMs) {
+  mCommandFn = commandFn;
+  mTimeoutMs = timeoutMs;
+  mState = parseSync0;
+  mType = 0;
+  mLength = 0;
+  mReceived = 0;
+  mCrc = CRC_INIT;
+  mFrameCrc = 0;
+  mPayload = nullptr;
+  memset(mFrames, 0, sizeof(mFrames));
+  mSlots[0] = 0;
+  mSlots[1] = 0;
+  mBack = 0;
+  mLastFrameMs = 0;
+  memset(mCommand, 0, sizeof(mCommand));
+  mResult = 0;
+  memset(&mStats, 0, sizeof(mStats));
+}
+
+uint32_t SerialLink::encode(uint8_t *output, uint8_t type, const uint8_t *payload, uint16_t length) {
+  uint16_t crc = CRC_INIT;
+
+  output[0] = SYNC_0;
+  output[1] = SYNC_1;
+  output[2] = type;
+  output[3] = length & 0xFF;
+  output[4] = length >> 8;
+  memcpy(&output[5], payload, length);
+
+  for (uint32_t i=2; i<5u + length; i++) {
+    crc = crcUpdate(crc, output[i]);
+  }
+
+  output[5 + length] = crc >> 8;
+  output[6 + length] = crc & 0xFF;
+
+  return length + SERIAL_LINK_OVERHEAD;
+}
+
+//slots are received straight into the back frame, so a frame is never copied
+bool SerialLink::beginPayload() {
+  if (mType == serialFrameSlots && mLength > 0 && mLength <= DMX_UNIVERSE_SLOTS) {
+    mPayload = mFrames[mBack];
+    return true;
+  }
+
+  if (mType == serialFrameCommand && mLength > 0 && mLength <= SERIAL_LINK_COMMAND_MAX) {
+    mPayload = (uint8_t*)mCommand;
+    return true;
+  }
+
+  return false;
+}
+
+SerialFrameType SerialLink::endFrame(uint32_t nowMs) {
+  if (mType == serialFrameSlots) {
+    mSlots[mBack] = mLength;
+    mLastFrameMs = nowMs;
+    mBack ^= 1;
+
+    //readers check the count to see if the frame changed under them
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    mStats.frames++;
+
+    return serialFrameSlots;
+  }
+
+  //the arguments follow the name's 0, a name without one has none
+  mCommand[mLength] = 0;
+
+  const uint32_t nameLength = strlen(mCommand);
+  const char *args = nameLength < mLength ? &mCommand[nameLength + 1] : &mCommand[mLength];
+
+  mResult = mCommandFn(mCommand, args);
+  mStats.commands++;
+
+  return serialFrameCommand;
+}
+
+uint8_t SerialLink::consume(uint8_t byte, uint32_t nowMs) {
+  switch (mState) {
+    case parseSync0:
+      mState = byte == SYNC_0 ? parseSync1 : parseSync0;
+      return 0;
+
+    case parseSync1:
+      mState = byte == SYNC_1 ? parseType : (byte == SYNC_0 ? parseSync1 : parseSync0);
+      return 0;
+
+    case parseType:
+      mType = byte;
+      mCrc = crcUpdate(CRC_INIT, byte);
+      mState = parseLengthLow;
+      return 0;
+
+    case parseLengthLow:
+      mLength = byte;
+      mCrc = crcUpdate(mCrc, byte);
+      mState = parseLengthHigh;
+      return 0;
+
+    case parseLengthHigh:
+      mLength |= byte << 8;
+      mCrc = crcUpdate(mCrc, byte);
+      mReceived = 0;
+
+      if (!beginPayload()) {
+        mStats.formatErrors++;
+        mState = parseSync0;
+        return 0;
+      }
+
+      mState = parsePayload;
+      return 0;
+
+    case parsePayload:
+      mPayload[mReceived++] = byte;
+      mCrc = crcUpdate(mCrc, byte);
+
+      if (mReceived == mLength) {
+        mState = parseCrcHigh;
+      }
+      return 0;
+
+    case parseCrcHigh:
+      mFrameCrc = byte << 8;
+      mState = parseCrcLow;
+      return 0;
+
+    case parseCrcLow:
+      mFrameCrc |= byte;
+      mState = parseSync0;
+
+      if (mFrameCrc != mCrc) {
+        mStats.crcErrors++;
+        return 0;
+      }
+
+      return endFrame(nowMs);
+  }
+
+  return 0;
+}
+
+uint32_t SerialLink::read(uint8_t *output, uint32_t firstSlot, uint32_t length) {
+  uint32_t frames;
+  uint32_t available;
+
+  do {
+    frames = mStats.frames;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    const uint8_t front = mBack ^ 1;
+    const uint32_t slots = frames == 0 ? 0 : mSlots[front];
+
+    available = slots > firstSlot ? slots - firstSlot : 0;
+    available = available < length ? available : length;
+
+    memcpy(output, &mFrames[front][firstSlot], available);
+
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  } while (frames != mStats.frames);
+
+  memset(&output[available], 0, length - available);
+
+  return available;
+}
+
+bool SerialLink::isLive(uint32_t nowMs) {
+  return mStats.frames > 0 && nowMs - mLastFrameMs < mTimeoutMs;
+}
@@ -0,0 +1,133 @@
+#ifndef OBELISK_SERIAL_LINK_H
+#define OBELISK_SERIAL_LINK_H
+
+#include "Particle.h"
+#include "dmxReceiver.h"
+
+/* longest command, the name, a 0 and the arguments */
+#define SERIAL_LINK_COMMAND_MAX 255
+/* sync word, type, length, payload and CRC */
+#define SERIAL_LINK_OVERHEAD 7
+#define SERIAL_LINK_UNKNOWN_COMMAND -100
+
+/*
+ * Frames on the link are a sync word (0xA5 0x5A), the type, the payload length
+ * (little endian), the payload then the CRC-16/CCITT-FALSE of the type, length
+ * and payload (big endian).
+ */
+enum SerialFrameType : uint8_t {
+  serialFrameSlots = 0x01,   /* LED values, a frame of up to a universe of slots */
+  serialFrameCommand = 0x02, /* a cloud function's name, a 0 then its arguments */
+  serialFrameReply = 0x82    /* the command's int32 result, little endian */
+};
+
+typedef struct {
+  uint32_t frames;       /* slot frames received */
+  uint32_t commands;     /* commands run */
+  uint32_t crcErrors;    /* frames dropped for their CRC */
+  uint32_t formatErrors; /* unknown types and lengths too long for the type */
+} serial_link_stats_t;
+
+/*
+ * Binary framed protocol for streaming frames and running commands from a PC
+ * over USB serial. Bytes are parsed one at a time as they're read, slots going
+ * straight into one of two frame buffers which swap on each good frame like
+ * DmxReceiver's.
+ */
+class SerialLink {
+private:
+  enum ParseState : uint8_t {
+    parseSync0,
+    parseSync1,
+    parseType,
+    parseLengthLow,
+    parseLengthHigh,
+    parsePayload,
+    parseCrcHigh,
+    parseCrcLow
+  };
+
+  int32_t (*mCommandFn)(const char *name, const char *args);
+  uint32_t mTimeoutMs;
+
+  ParseState mState;
+  uint8_t mType;
+  uint16_t mLength;
+  uint16_t mReceived;
+  uint16_t mCrc;
+  uint16_t mFrameCrc;
+  uint8_t *mPayload;
+
+  uint8_t mFrames[2][DMX_UNIVERSE_SLOTS];
+  uint16_t mSlots[2];
+  uint8_t mBack;
+  uint32_t mLastFrameMs;
+  char mCommand[SERIAL_LINK_COMMAND_MAX + 1];
+  int32_t mResult;
+  serial_link_stats_t mStats;
+
+  bool beginPayload();
+  SerialFrameType endFrame(uint32_t nowMs);
+
+public:
+  /**
+   * @param commandFn runs a command by name, returning its result
+   * @param timeoutMs frames are no longer live this long after the last one
+   */
+  SerialLink(int32_t (*commandFn)(const char *name, const char *args), uint32_t timeoutMs);
+
+  /**
+   * Parse the next byte received
+   * @return type of the frame it completed, 0 if it didn't
+   */
+  uint8_t consume(uint8_t byte, uint32_t nowMs);
+
+  /**
+   * Encode a frame
+   * @param output length + SERIAL_LINK_OVERHEAD bytes
+   * @return bytes written
+   */
+  static uint32_t encode(uint8_t *output, uint8_t type, const uint8_t *payload, uint16_t length);
+
+  /**
+   * Parse the bytes waiting on the port without blocking, replying to commands
+   * @param port has Stream's available(), read() and write(buffer, length)
+   * @return bytes parsed
+   */
+  template <typename Port>
+  uint32_t poll(Port *port, uint32_t nowMs) {
+    int32_t available = port->available();
+    uint32_t parsed = 0;
+
+    while (available-- > 0) {
+      const int byte = port->read();
+
+      if (byte < 0) {
+        break;
+      }
+
+      parsed++;
+
+      if (consume(byte, nowMs) == serialFrameCommand) {
+        uint8_t reply[sizeof(mResult) + SERIAL_LINK_OVERHEAD];
+        const uint8_t result[] = {
+          (uint8_t)mResult, (uint8_t)(mResult >> 8), (uint8_t)(mResult >> 16), (uint8_t)(mResult >> 24)
+        };
+
+        port->write(reply, encode(reply, serialFrameReply, result, sizeof(result)));
+      }
+    }
+
+    return parsed;
+  }
+
+  /* Copy slots from the last frame, see DmxReceiver::read() */
+  uint32_t read(uint8_t *output, uint32_t firstSlot, uint32_t length);
+
+  /* Whether a frame arrived within the timeout */
+  bool isLive(uint32_t nowMs);
+
+  const serial_link_stats_t* stats() { return &mStats; };
+};
+
+#endif
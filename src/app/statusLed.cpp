@@ -1,61 +1,35 @@
 #include "Particle.h"
 #include "config.h"
-#include "colour.h"
-#include "ledStripDriver.h"
+#include "indicator.h"
 #include "statusLed.h"
 
-//need COLOURS_PER_LED values to use ledStripDriver, even only one is required
-static uint8_t statusLedValues[1 * COLOURS_PER_LED];
+static indicator_t statusIndicator;
+static bool statusOn;
 
-static LedStripDriver *statusLedDriver;
-static led_strip_state_t statusLedState;
-
-//ensure the first value is the correct LED state
-#ifdef COLOUR_ORDER_GGRRBB
-static const Colour STATUS_COLOUR_ON(0, 1, 0);
-#else
-static const Colour STATUS_COLOUR_ON(1, 0, 0);
-#endif
-
-static const Colour STATUS_COLOUR_OFF(0, 0, 0);
-
-static const led_strip_config_t CONFIG_STATUS_LED = {
-  .numLeds = 1,
-  .writeValueFn = statusLed::update,
-  .resolutionMs = TIMER_RESOLUTION_STATUS_LED_MS,
-};
+static void setLed(bool on) {
+  //LED is active low
+  digitalWrite(PIN_STATUS_LED, on ? LOW : HIGH);
+  statusOn = on;
+}
 
 static void flashLED(uint32_t periodMs) {
-  statusLedDriver->pattern(Pattern::strobe)
-    ->period(periodMs)
-    ->colourOn((Colour*)&STATUS_COLOUR_ON);
+  indicator::set(&statusIndicator, periodMs, periodMs / 2);
 }
 
-// namespace statusLed {
 void statusLed::setup() {
   pinMode(PIN_STATUS_LED, OUTPUT);
+  setLed(false);
 
-  statusLedDriver = new LedStripDriver((led_strip_config_t*)&CONFIG_STATUS_LED);
-  statusLedDriver->initState(&statusLedState);
-
-  statusLedDriver->pattern(Pattern::strobe)
-    ->period(STATUS_RAPID_FLASH_PERIOD_MS)
-    ->colourOn((Colour*)&STATUS_COLOUR_ON)
-    ->colourOff((Colour*)&STATUS_COLOUR_OFF);
+  flashLED(STATUS_RAPID_FLASH_PERIOD_MS);
 }
 
-void statusLed::update(uint8_t *value, uint32_t length) {
-  uint8_t ledVal = HIGH; //LED off
+//only touch the pin when the state changes
+void statusLed::onTimerFired() {
+  const bool on = indicator::tick(&statusIndicator, TIMER_RESOLUTION_STATUS_LED_MS);
 
-  if (*value == 1) {
-    ledVal = LOW; //turn LED on
+  if (on != statusOn) {
+    setLed(on);
   }
-
-  digitalWrite(PIN_STATUS_LED, ledVal);
-}
-
-void statusLed::onTimerFired() {
-  statusLedDriver->onTimerFired(&statusLedState, statusLedValues);
 }
 
 void statusLed::rapidFlash() {
@@ -71,10 +45,5 @@ void statusLed::slowFlash() {
 }
 
 void statusLed::blink() {
-  statusLedDriver->pattern(Pattern::blink)
-    ->period(STATUS_BLINK_PERIOD_MS)
-    ->dutyCycle(10)
-    ->colourOn((Colour*)&STATUS_COLOUR_ON)
-    ->colourOff((Colour*)&STATUS_COLOUR_OFF);
+  indicator::set(&statusIndicator, STATUS_BLINK_PERIOD_MS, STATUS_BLINK_PERIOD_MS / 10);
 }
-// };
@@ -9,8 +9,6 @@ namespace statusLed {
 
   void onTimerFired();
   void setup();
-
-  void update(uint8_t *value, uint32_t length);
 };
 
 #endif
@@ -0,0 +1,33 @@
+#include "stream.h"
+#include "config.h"
+
+namespace stream {
+  static const stream_receiver_config_t CONFIG_STREAM = {
+    .protocol = STREAM_PROTOCOL,
+    .universe = STREAM_UNIVERSE,
+    .timeoutMs = STREAM_TIMEOUT_MS,
+  };
+
+  static StreamReceiver streamReceiver(&CONFIG_STREAM);
+  static UDP udp;
+  static bool listening;
+
+  //sockets are closed when the cellular connection drops
+  void poll() {
+    if (!Cellular.ready()) {
+      listening = false;
+      return;
+    }
+
+    if (!listening) {
+      listening = udp.begin(StreamReceiver::port(STREAM_PROTOCOL));
+      return;
+    }
+
+    streamReceiver.poll(&udp, millis());
+  }
+
+  StreamReceiver* receiver() {
+    return &streamReceiver;
+  }
+}
@@ -0,0 +1,18 @@
+#ifndef OBELISK_STREAM_H
+#define OBELISK_STREAM_H
+
+#include "Particle.h"
+#include "streamReceiver.h"
+
+/*
+ * Listens for sACN or Art-Net universes over UDP (STREAM_PROTOCOL in config.h),
+ * for show control without the cloud round trip.
+ */
+namespace stream {
+  /* Receive any datagrams waiting, from the application loop, opening the socket once the network is up */
+  void poll();
+
+  StreamReceiver* receiver();
+}
+
+#endif
@@ -0,0 +1,218 @@
+#include "streamReceiver.h"
+#include <atomic>
+#include <string.h>
+
+static const uint16_t PORT_SACN = 5568;
+static const uint16_t PORT_ARTNET = 6454;
+static const uint8_t START_CODE_NULL = 0;
+
+//E1.31 data packet, fields are big endian
+static const uint8_t SACN_PACKET_ID[] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+static const uint32_t SACN_OFFSET_PACKET_ID = 4;
+static const uint32_t SACN_OFFSET_ROOT_VECTOR = 18;
+static const uint32_t SACN_OFFSET_FRAMING_VECTOR = 40;
+static const uint32_t SACN_OFFSET_SEQUENCE = 111;
+static const uint32_t SACN_OFFSET_OPTIONS = 112;
+static const uint32_t SACN_OFFSET_UNIVERSE = 113;
+static const uint32_t SACN_OFFSET_DMP_VECTOR = 117;
+static const uint32_t SACN_OFFSET_ADDRESS_TYPE = 118;
+static const uint32_t SACN_OFFSET_VALUE_COUNT = 123;
+static const uint32_t SACN_OFFSET_START_CODE = 125;
+static const uint32_t SACN_HEADER_LENGTH = 126;
+static const uint32_t SACN_VECTOR_ROOT_DATA = 0x00000004;
+static const uint32_t SACN_VECTOR_FRAMING_DATA = 0x00000002;
+static const uint8_t SACN_VECTOR_DMP_SET_PROPERTY = 0x02;
+static const uint8_t SACN_ADDRESS_TYPE = 0xA1;
+static const uint8_t SACN_OPTION_PREVIEW = 0x80;
+static const uint8_t SACN_OPTION_TERMINATED = 0x40;
+
+//ArtDmx packet, the opcode is little endian and the rest big endian
+static const uint8_t ARTNET_ID[] = {'A', 'r', 't', '-', 'N', 'e', 't', 0};
+static const uint32_t ARTNET_OFFSET_OPCODE = 8;
+static const uint32_t ARTNET_OFFSET_VERSION = 10;
+static const uint32_t ARTNET_OFFSET_SEQUENCE = 12;
+static const uint32_t ARTNET_OFFSET_PORT_ADDRESS = 14;
+static const uint32_t ARTNET_OFFSET_LENGTH = 16;
+static const uint32_t ARTNET_HEADER_LENGTH = 18;
+static const uint16_t ARTNET_OPCODE_DMX = 0x5000;
+static const uint16_t ARTNET_VERSION = 14;
+static const uint8_t ARTNET_SEQUENCE_DISABLED = 0;
+
+/* E1.31 6.7.2, a sequence number up to 20 behind the last is out of order, further is a restart */
+static const int8_t SEQUENCE_WINDOW = -20;
+
+static inline uint16_t readUint16(const uint8_t *bytes) {
+  return (bytes[0] << 8) | bytes[1];
+}
+
+static inline uint32_t readUint32(const uint8_t *bytes) {
+  return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+}
+
+StreamReceiver::StreamReceiver(const stream_receiver_config_t *config) {
+  mConfig = config;
+  memset(mPacket, 0, sizeof(mPacket));
+  memset(mFrames, 0, sizeof(mFrames));
+  mSlots[0] = 0;
+  mSlots[1] = 0;
+  mBack = 0;
+  mStarted = false;
+  mTerminated = false;
+  mSequence = 0;
+  mLastFrameMs = 0;
+  memset(&mStats, 0, sizeof(mStats));
+}
+
+uint16_t StreamReceiver::port(StreamProtocol protocol) {
+  return protocol == streamArtNet ? PORT_ARTNET : PORT_SACN;
+}
+
+bool StreamReceiver::isInOrder(uint8_t sequence) {
+  const int8_t behind = (int8_t)(sequence - mSequence);
+
+  return !mStarted || behind > 0 || behind <= SEQUENCE_WINDOW;
+}
+
+void StreamReceiver::acceptFrame(const uint8_t *slots, uint32_t length, uint8_t sequence, uint32_t nowMs) {
+  if (length > DMX_UNIVERSE_SLOTS) {
+    length = DMX_UNIVERSE_SLOTS;
+  }
+
+  memcpy(mFrames[mBack], slots, length);
+  mSlots[mBack] = length;
+  mBack ^= 1;
+
+  mStarted = true;
+  mTerminated = false;
+  mSequence = sequence;
+  mLastFrameMs = nowMs;
+
+  //readers check the count to see if the frame changed under them
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  mStats.frames++;
+}
+
+bool StreamReceiver::receiveSacn(const uint8_t *packet, uint32_t length, uint32_t nowMs) {
+  if (length < SACN_HEADER_LENGTH ||
+      memcmp(&packet[SACN_OFFSET_PACKET_ID], SACN_PACKET_ID, sizeof(SACN_PACKET_ID)) != 0 ||
+      readUint32(&packet[SACN_OFFSET_ROOT_VECTOR]) != SACN_VECTOR_ROOT_DATA ||
+      readUint32(&packet[SACN_OFFSET_FRAMING_VECTOR]) != SACN_VECTOR_FRAMING_DATA ||
+      packet[SACN_OFFSET_DMP_VECTOR] != SACN_VECTOR_DMP_SET_PROPERTY ||
+      packet[SACN_OFFSET_ADDRESS_TYPE] != SACN_ADDRESS_TYPE) {
+    mStats.badPackets++;
+    return false;
+  }
+
+  //the value count includes the start code
+  const uint32_t values = readUint16(&packet[SACN_OFFSET_VALUE_COUNT]);
+
+  if (values < 1 || SACN_OFFSET_START_CODE + values > length) {
+    mStats.badPackets++;
+    return false;
+  }
+
+  const uint8_t options = packet[SACN_OFFSET_OPTIONS];
+
+  if (readUint16(&packet[SACN_OFFSET_UNIVERSE]) != mConfig->universe ||
+      packet[SACN_OFFSET_START_CODE] != START_CODE_NULL ||
+      (options & SACN_OPTION_PREVIEW) != 0) {
+    mStats.otherUniverses++;
+    return false;
+  }
+
+  const uint8_t sequence = packet[SACN_OFFSET_SEQUENCE];
+
+  if (!isInOrder(sequence)) {
+    mStats.outOfOrder++;
+    return false;
+  }
+
+  //the source has stopped, go back to the pattern now rather than at the timeout
+  if ((options & SACN_OPTION_TERMINATED) != 0) {
+    mTerminated = true;
+    mStarted = false;
+    return false;
+  }
+
+  acceptFrame(&packet[SACN_HEADER_LENGTH], values - 1, sequence, nowMs);
+  return true;
+}
+
+bool StreamReceiver::receiveArtNet(const uint8_t *packet, uint32_t length, uint32_t nowMs) {
+  if (length < ARTNET_HEADER_LENGTH ||
+      memcmp(packet, ARTNET_ID, sizeof(ARTNET_ID)) != 0 ||
+      (packet[ARTNET_OFFSET_OPCODE] | (packet[ARTNET_OFFSET_OPCODE + 1] << 8)) != ARTNET_OPCODE_DMX ||
+      readUint16(&packet[ARTNET_OFFSET_VERSION]) < ARTNET_VERSION) {
+    mStats.badPackets++;
+    return false;
+  }
+
+  const uint32_t slots = readUint16(&packet[ARTNET_OFFSET_LENGTH]);
+
+  if (slots < 1 || ARTNET_HEADER_LENGTH + slots > length) {
+    mStats.badPackets++;
+    return false;
+  }
+
+  //port address is net then sub-net and universe, 15 bits
+  const uint16_t portAddress = (packet[ARTNET_OFFSET_PORT_ADDRESS + 1] << 8) | packet[ARTNET_OFFSET_PORT_ADDRESS];
+
+  if (portAddress != mConfig->universe) {
+    mStats.otherUniverses++;
+    return false;
+  }
+
+  const uint8_t sequence = packet[ARTNET_OFFSET_SEQUENCE];
+
+  if (sequence != ARTNET_SEQUENCE_DISABLED && !isInOrder(sequence)) {
+    mStats.outOfOrder++;
+    return false;
+  }
+
+  acceptFrame(&packet[ARTNET_HEADER_LENGTH], slots, sequence, nowMs);
+  return true;
+}
+
+bool StreamReceiver::receive(const uint8_t *packet, uint32_t length, uint32_t nowMs) {
+  mStats.packets++;
+
+  //a source that went quiet may have restarted its sequence
+  if (mStarted && nowMs - mLastFrameMs >= mConfig->timeoutMs) {
+    mStarted = false;
+  }
+
+  if (mConfig->protocol == streamArtNet) {
+    return receiveArtNet(packet, length, nowMs);
+  }
+
+  return receiveSacn(packet, length, nowMs);
+}
+
+//frames are received on the application thread and read on the render thread
+uint32_t StreamReceiver::read(uint8_t *output, uint32_t firstSlot, uint32_t length) {
+  uint32_t frames;
+  uint32_t available;
+
+  do {
+    frames = mStats.frames;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    const uint8_t front = mBack ^ 1;
+    const uint32_t slots = frames == 0 ? 0 : mSlots[front];
+
+    available = slots > firstSlot ? slots - firstSlot : 0;
+    available = available < length ? available : length;
+
+    memcpy(output, &mFrames[front][firstSlot], available);
+
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  } while (frames != mStats.frames);
+
+  memset(&output[available], 0, length - available);
+
+  return available;
+}
+
+bool StreamReceiver::isLive(uint32_t nowMs) {
+  return mStats.frames > 0 && !mTerminated && nowMs - mLastFrameMs < mConfig->timeoutMs;
+}
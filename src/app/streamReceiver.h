@@ -0,0 +1,93 @@
+#ifndef OBELISK_STREAM_RECEIVER_H
+#define OBELISK_STREAM_RECEIVER_H
+
+#include "Particle.h"
+#include "dmxReceiver.h"
+
+/* largest datagram, an E1.31 header and a full universe */
+#define STREAM_PACKET_MAX (126 + DMX_UNIVERSE_SLOTS)
+
+/* How universes are streamed over UDP */
+enum StreamProtocol : uint8_t {
+  streamOff,
+  streamSacn,  /* ANSI E1.31, port 5568 */
+  streamArtNet /* Art-Net ArtDmx, port 6454 */
+};
+
+typedef struct {
+  StreamProtocol protocol;
+  uint16_t universe;   /* sACN universe or Art-Net port address */
+  uint32_t timeoutMs;  /* frames are no longer live this long after the last one */
+} stream_receiver_config_t;
+
+typedef struct {
+  uint32_t packets;        /* datagrams received */
+  uint32_t frames;         /* frames for our universe */
+  uint32_t badPackets;     /* not a DMX data packet of the protocol */
+  uint32_t otherUniverses; /* valid, for another universe */
+  uint32_t outOfOrder;     /* older than the last frame, dropped */
+} stream_stats_t;
+
+/*
+ * Universes streamed as sACN or Art-Net datagrams. Packets are validated where
+ * they were received and only the slots are copied, into one of two frame
+ * buffers which swap on each frame like DmxReceiver's.
+ */
+class StreamReceiver {
+private:
+  const stream_receiver_config_t *mConfig;
+  uint8_t mPacket[STREAM_PACKET_MAX];
+  uint8_t mFrames[2][DMX_UNIVERSE_SLOTS];
+  uint16_t mSlots[2];
+  uint8_t mBack;
+  bool mStarted;
+  bool mTerminated;
+  uint8_t mSequence;
+  uint32_t mLastFrameMs;
+  stream_stats_t mStats;
+
+  bool isInOrder(uint8_t sequence);
+  void acceptFrame(const uint8_t *slots, uint32_t length, uint8_t sequence, uint32_t nowMs);
+  bool receiveSacn(const uint8_t *packet, uint32_t length, uint32_t nowMs);
+  bool receiveArtNet(const uint8_t *packet, uint32_t length, uint32_t nowMs);
+
+public:
+  StreamReceiver(const stream_receiver_config_t *config);
+
+  /* UDP port of the protocol */
+  static uint16_t port(StreamProtocol protocol);
+
+  /**
+   * Handle a datagram
+   * @return whether it was a frame for our universe
+   */
+  bool receive(const uint8_t *packet, uint32_t length, uint32_t nowMs);
+
+  /**
+   * Receive every datagram waiting on the socket, straight into the packet
+   * buffer, without blocking
+   * @param socket has Particle UDP's receivePacket()
+   * @return frames received
+   */
+  template <typename Socket>
+  uint32_t poll(Socket *socket, uint32_t nowMs) {
+    uint32_t frames = 0;
+    int length;
+
+    while ((length = socket->receivePacket(mPacket, sizeof(mPacket))) > 0) {
+      frames += receive(mPacket, length, nowMs) ? 1 : 0;
+    }
+
+    return frames;
+  }
+
+  /* Copy slots from the last frame, see DmxReceiver::read() */
+  uint32_t read(uint8_t *output, uint32_t firstSlot, uint32_t length);
+
+  /* Whether a frame arrived within the timeout and the source hasn't stopped the stream */
+  bool isLive(uint32_t nowMs);
+
+  const stream_stats_t* stats() { return &mStats; };
+};
+
+#endif
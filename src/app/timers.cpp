@@ -1,13 +1,68 @@
 #include "Particle.h"
+#include "concurrent_hal.h"
 #include "config.h"
 #include "timers.h"
 #include "ledStrip.h"
 #include "statusLed.h"
 
-Timer ledTimer(TIMER_RESOLUTION_MS, ledStrip::onTimerFired);
-Timer statusLedTimer(TIMER_RESOLUTION_STATUS_LED_MS, statusLed::onTimerFired);
+typedef struct {
+  void (*fn)();
+  uint32_t periodMs;
+  uint32_t dueMs;
+} render_task_t;
+
+static render_task_t tasks[] = {
+  { .fn = ledStrip::onTimerFired, .periodMs = TIMER_RESOLUTION_MS, .dueMs = 0 },
+  { .fn = statusLed::onTimerFired, .periodMs = TIMER_RESOLUTION_STATUS_LED_MS, .dueMs = 0 },
+};
+
+static const uint32_t TASK_COUNT = sizeof(tasks) / sizeof(tasks[0]);
+
+static Thread *renderThread;
+static volatile uint32_t deadlineMisses;
+
+//a task is released at its due time and must finish before the next release
+static void runTasks(uint32_t nowMs) {
+  for (uint32_t i=0; i<TASK_COUNT; i++) {
+    render_task_t *task = &tasks[i];
+
+    if ((int32_t)(nowMs - task->dueMs) < 0) {
+      continue;
+    }
+
+    task->fn();
+    task->dueMs += task->periodMs;
+
+    //overran into later releases, skip them rather than run back to back
+    if ((int32_t)(millis() - task->dueMs) >= 0) {
+      deadlineMisses++;
+      task->dueMs = millis() + task->periodMs;
+    }
+  }
+}
+
+//wakes are relative to the last wake rather than when the work finished, so the period doesn't drift
+static void renderLoop(void *param) {
+  system_tick_t lastWakeMs = millis();
+
+  for (uint32_t i=0; i<TASK_COUNT; i++) {
+    tasks[i].dueMs = lastWakeMs;
+  }
+
+  while (true) {
+    runTasks(millis());
+    os_thread_delay_until(&lastWakeMs, RENDER_THREAD_PERIOD_MS);
+  }
+}
 
 void timers::setup() {
-  statusLedTimer.start();
-  ledTimer.start();
+  renderThread = new Thread("render",
+                            renderLoop,
+                            nullptr,
+                            RENDER_THREAD_PRIORITY,
+                            RENDER_THREAD_STACK_SIZE);
+}
+
+uint32_t timers::deadlineMisses() {
+  return ::deadlineMisses;
 }
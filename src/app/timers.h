@@ -1,8 +1,18 @@
 #ifndef OBELISK_TIMERS_H
 #define OBELISK_TIMERS_H
 
+#include "Particle.h"
+
+/*
+ * Periodic work for the strip and status LED, run from a dedicated thread at
+ * RENDER_THREAD_PRIORITY rather than the shared software timer thread, so
+ * frames keep their timing while the modem is busy.
+ */
 namespace timers {
   void setup();
+
+  /* Times a task was still running when it was next due */
+  uint32_t deadlineMisses();
 }
 
 #endif
@@ -0,0 +1,82 @@
+#include "transition.h"
+#include "config.h"
+#include <string.h>
+
+#define ALPHA_MAX 256
+
+void blendValues(uint8_t *values, const uint8_t *from, uint32_t length, uint32_t alpha) {
+  const uint32_t inverse = ALPHA_MAX - alpha;
+
+  for (uint32_t i=0; i < length; i++) {
+    values[i] = (uint8_t)((values[i] * alpha + from[i] * inverse) >> 8);
+  }
+}
+
+Transition::Transition(led_strip_config_t *config, uint8_t *outgoingValues)
+  : mOutgoing(config) {
+  mConfig = config;
+  mOutgoingValues = outgoingValues;
+  mActive = false;
+  mFrozen = false;
+  mDurationMs = 0;
+  mStartMs = 0;
+  mElapsedMs = 0;
+}
+
+uint32_t Transition::elapsedMs() {
+  return mConfig->timeFn != nullptr ? mConfig->timeFn() - mStartMs : mElapsedMs;
+}
+
+void Transition::begin(LedStripDriver *current, led_strip_state_t *state, const uint8_t *lastValues,
+                       uint32_t durationMs) {
+  //the strip shows a mix of two patterns, neither of which can be picked up without a jump
+  mFrozen = mActive;
+
+  if (mFrozen) {
+    memcpy(mOutgoingValues, lastValues, COLOURS_PER_LED * mConfig->numLeds);
+  } else {
+    mOutgoing = *current;
+    mOutgoing.retainColours(mOutgoingColours);
+    mOutgoingState = *state;
+  }
+
+  mActive = durationMs > 0;
+  mDurationMs = durationMs;
+  mStartMs = mConfig->timeFn != nullptr ? mConfig->timeFn() : 0;
+  mElapsedMs = 0;
+}
+
+void Transition::onTimerFired(LedStripDriver *incoming, led_strip_state_t *state, uint8_t *values) {
+  const uint32_t numLedValues = COLOURS_PER_LED * mConfig->numLeds;
+
+  incoming->render(state, values);
+
+  if (mActive) {
+    const uint32_t elapsed = elapsedMs();
+
+    if (elapsed < mDurationMs) {
+      if (!mFrozen) {
+        mOutgoing.render(&mOutgoingState, mOutgoingValues);
+      }
+
+      blendValues(values, mOutgoingValues, numLedValues, (elapsed * ALPHA_MAX) / mDurationMs);
+      mElapsedMs += mConfig->resolutionMs;
+    } else {
+      mActive = false;
+    }
+  }
+
+  mConfig->writeValueFn(values, numLedValues);
+}
+
+void Transition::skipFrame() {
+  if (!mActive) {
+    return;
+  }
+
+  if (!mFrozen) {
+    mOutgoing.render(&mOutgoingState, mOutgoingValues);
+  }
+
+  mElapsedMs += mConfig->resolutionMs;
+}
@@ -0,0 +1,60 @@
+#ifndef OBELISK_TRANSITION_H
+#define OBELISK_TRANSITION_H
+
+#include "colour.h"
+#include "ledStripDriver.h"
+
+/*
+ * Crossfades from the previous pattern to the current one. The outgoing
+ * pattern keeps rendering from a snapshot of the driver and its state into a
+ * second buffer, which is blended with the incoming pattern per channel. A
+ * pattern set part way through a fade fades from the blended frame on the
+ * strip, held still, rather than jumping to the pattern that was fading in.
+ * The fade runs on the config's clock when it has one, so it keeps time with
+ * the patterns when frames are skipped.
+ */
+class Transition {
+private:
+  led_strip_config_t *mConfig;
+  LedStripDriver mOutgoing;
+  led_strip_state_t mOutgoingState;
+  Colour mOutgoingColours[DRIVER_COLOUR_COUNT];
+  uint8_t *mOutgoingValues;
+
+  bool mActive;
+  bool mFrozen; /* fading from a held frame, the outgoing pattern isn't rendered */
+  uint32_t mDurationMs;
+  uint32_t mStartMs;
+  uint32_t mElapsedMs; /* without a clock, time advances by resolutionMs per frame */
+
+  uint32_t elapsedMs();
+
+public:
+  /* outgoingValues must be the same length as the values rendered by the driver */
+  Transition(led_strip_config_t *config, uint8_t *outgoingValues);
+
+  /**
+   * Snapshot the current pattern and fade from it over durationMs (0 = hard cut)
+   * @param lastValues the frame last written, faded from instead if a fade is under way
+   */
+  void begin(LedStripDriver *current, led_strip_state_t *state, const uint8_t *lastValues,
+             uint32_t durationMs);
+
+  /* Render the incoming pattern, blended with the outgoing one while fading, and write it out */
+  void onTimerFired(LedStripDriver *incoming, led_strip_state_t *state, uint8_t *values);
+
+  /* Step the outgoing pattern through a frame that isn't sent, alongside the incoming one */
+  void skipFrame();
+
+  bool isActive() { return mActive; };
+};
+
+/*
+ * Blend from -> values in place with alpha in 1/256ths
+ * eg 0   -> from only
+ *    128 -> equal mix
+ *    256 -> values only
+ */
+void blendValues(uint8_t *values, const uint8_t *from, uint32_t length, uint32_t alpha);
+
+#endif
@@ -0,0 +1,30 @@
+#include "usbLink.h"
+#include "config.h"
+
+namespace usbLink {
+  static int32_t (*commandFn)(const char *name, const char *args) = nullptr;
+
+  static int32_t runCommand(const char *name, const char *args) {
+    return commandFn != nullptr ? commandFn(name, args) : SERIAL_LINK_UNKNOWN_COMMAND;
+  }
+
+  //static so the render thread can check for frames before setup
+  static SerialLink serialLink(runCommand, SERIAL_LINK_TIMEOUT_MS);
+
+  void setup(int32_t (*fn)(const char *name, const char *args)) {
+    commandFn = fn;
+
+    //the baud rate means nothing over USB
+    Serial.begin(115200);
+  }
+
+  //USB flow control holds the PC back while the receive buffer is full, so nothing is lost
+  //if the loop is slow to get to it
+  void poll() {
+    serialLink.poll(&Serial, millis());
+  }
+
+  SerialLink* link() {
+    return &serialLink;
+  }
+}
@@ -0,0 +1,21 @@
+#ifndef OBELISK_USB_LINK_H
+#define OBELISK_USB_LINK_H
+
+#include "Particle.h"
+#include "serialLink.h"
+
+/*
+ * SerialLink over USB serial, for a PC to stream frames and run commands
+ * without the cloud (SERIAL_LINK_ENABLED in config.h)
+ */
+namespace usbLink {
+  /* @param commandFn runs a cloud function by name */
+  void setup(int32_t (*commandFn)(const char *name, const char *args));
+
+  /* Parse what's waiting in USB serial's receive buffer, from the application loop */
+  void poll();
+
+  SerialLink* link();
+}
+
+#endif
@@ -3,73 +3,108 @@
 #define RET_VAL_SUC 0
 #define RET_VAL_ERR -1
 
-static const uint8_t BASE_16 = 16;
+static const uint8_t OFFSET_NUMBERS = 48;
 
-static const uint8_t VAL_NUM_MIN = 48;
-static const uint8_t VAL_NUM_MAX = 48+9;
-static const uint8_t VAL_HEX_LC_MIN = 97;
-static const uint8_t VAL_HEX_LC_MAX = 102;
-static const uint8_t VAL_HEX_UC_MIN = 65;
-static const uint8_t VAL_HEX_UC_MAX = 70;
+static const uint8_t HEX_INVALID = 0xFF;
+#define XX HEX_INVALID
+
+/* Value of each character as a hex digit, HEX_INVALID for anything else */
+static const uint8_t HEX_NIBBLE[256] = {
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+   0,  1,  2,  3,  4,  5,  6,  7,  8,  9, XX, XX, XX, XX, XX, XX,
+  XX, 10, 11, 12, 13, 14, 15, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, 10, 11, 12, 13, 14, 15, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+};
+#undef XX
 
-static const uint8_t OFFSET_NUMBERS = 48;
-static const uint8_t OFFSET_HEX_UPPERCASE = 55;
-static const uint8_t OFFSET_HEX_LOWERCASE = 87;
-
-static uint8_t convertChar(char c) {
-  uint8_t val = -1;
-
-  if (c >= VAL_NUM_MIN && c <= VAL_NUM_MAX) {
-    val = c - OFFSET_NUMBERS;
-  } else if (c >= VAL_HEX_LC_MIN && c <= VAL_HEX_LC_MAX) {
-    val = c - OFFSET_HEX_LOWERCASE;
-  } else if (c >= VAL_HEX_UC_MIN && c <= VAL_HEX_UC_MAX) {
-    val = c - OFFSET_HEX_UPPERCASE;
+/**
+ * Convert the leading hex digits of a string to an unsigned int, stopping at the
+ * first character that isn't a hex digit
+ */
+uint32_t hexStrToInt(const char *hexStr) {
+  uint32_t val = 0;
+  uint8_t nibble;
+
+  while ((nibble = HEX_NIBBLE[(uint8_t)*hexStr++]) != HEX_INVALID) {
+    val = (val << 4) | nibble;
   }
 
   return val;
 }
 
-uint32_t hexStrToInt(String hexStr) {
-    uint32_t val = 0;
-    uint32_t len = hexStr.length();
+/**
+ * Convert exactly digits hex digits to an unsigned int in a single pass
+ * @param value parsed value, left untouched on error
+ * @param str string to parse, read no further than the first non hex digit
+ * @param digits number of digits to convert (8 max)
+ * @return 0 for success, -1 if any of the digits isn't a hex digit
+ */
+int32_t hexDigitsToInt(uint32_t *value, const char *str, uint32_t digits) {
+  uint32_t val = 0;
 
-    for (uint32_t i=0; i < len; i++) {
-      uint32_t pos = len - i - 1; // position in number
-      uint32_t converted = convertChar(hexStr.charAt(i));
+  for (uint32_t i=0; i < digits; i++) {
+    const uint8_t nibble = HEX_NIBBLE[(uint8_t)str[i]];
 
-      val += pos > 0 ? BASE_16 * pos * converted : converted;
+    if (nibble == HEX_INVALID) {
+      return RET_VAL_ERR;
     }
 
-    return val;
+    val = (val << 4) | nibble;
+  }
+
+  *value = val;
+  return RET_VAL_SUC;
 }
 
+/* Largest value that can be multiplied by 10 without overflowing, and the digit limit at it */
+static const uint32_t DEC_MUL_MAX = UINT32_MAX / 10;
+static const uint32_t DEC_DIGIT_MAX = UINT32_MAX % 10;
+
 /**
- * Convert a string to an unsigned int (no negative numbers)
- * @param value parsed value
- * @param str string to parse
- * @return 0 for success, -1 for error
+ * Convert a decimal string to an unsigned int (no negative numbers) in a single
+ * forward pass
+ * @param value parsed value, saturated at UINT32_MAX if the number doesn't fit
+ * @param str digits to parse, needn't be null terminated
+ * @param length number of characters to parse
+ * @return 0 for success, -1 for an empty string, non digit or overflow
  */
-int32_t strToInt(uint32_t *value, String str) {
-  uint32_t len = str.length();
-  uint32_t exp = 0;
+int32_t strToInt(uint32_t *value, const char *str, uint32_t length) {
+  uint32_t val = 0;
 
   *value = 0;
 
-  if (len == 0) {
+  if (length == 0) {
     return RET_VAL_ERR;
   }
 
-  for (int32_t i=(len - 1); i >= 0; i--) {
-    char c = str.charAt(i);
+  for (uint32_t i=0; i < length; i++) {
+    const uint32_t digit = (uint8_t)str[i] - OFFSET_NUMBERS;
+
+    //unsigned, so characters below '0' wrap round to large values too
+    if (digit > 9) {
+      return RET_VAL_ERR;
+    }
 
-    if (c < OFFSET_NUMBERS || c > (OFFSET_NUMBERS + 9)) {
+    if (val > DEC_MUL_MAX || (val == DEC_MUL_MAX && digit > DEC_DIGIT_MAX)) {
+      *value = UINT32_MAX;
       return RET_VAL_ERR;
     }
 
-    *value += ((uint32_t)c - OFFSET_NUMBERS) * (exp > 0 ? exp : 1);
-    exp = exp > 0 ? exp*10 : 10;
+    val = val * 10 + digit;
   }
 
+  *value = val;
   return RET_VAL_SUC;
 }
@@ -3,7 +3,12 @@
 
 #include "Particle.h"
 
-extern uint32_t hexStrToInt(String hexStr);
-extern int32_t strToInt(uint32_t *value, String str);
+extern uint32_t hexStrToInt(const char *hexStr);
+extern int32_t hexDigitsToInt(uint32_t *value, const char *str, uint32_t digits);
+extern int32_t strToInt(uint32_t *value, const char *str, uint32_t length);
+
+inline int32_t strToInt(uint32_t *value, const String& str) {
+  return strToInt(value, str.c_str(), str.length());
+}
 
 #endif
@@ -0,0 +1,42 @@
+#include "ws2812.h"
+#include "config.h"
+#include "ledSpiEncoder.h"
+
+//the line is held low for the reset between frames, which the strip latches on
+#define RESET_BYTES ((WS2812_RESET_US * (WS2812_SPI_CLOCK_HZ / 1000) / 1000 + 7) / 8)
+#define FRAME_BYTES (NUM_LEDS * COLOURS_PER_LED * WS2812_SPI_BITS)
+
+namespace ws2812 {
+  static uint8_t buffer[FRAME_BYTES + RESET_BYTES];
+  static volatile bool sending;
+
+  //called from the DMA interrupt
+  static void onSent() {
+    sending = false;
+  }
+
+  void setup() {
+    LED_SPI.begin();
+    LED_SPI.setBitOrder(MSBFIRST);
+    LED_SPI.setDataMode(SPI_MODE0);
+    LED_SPI.setClockSpeed(WS2812_SPI_CLOCK_HZ);
+
+    sending = false;
+  }
+
+  void send(const uint8_t *values, uint32_t length) {
+    if (sending) {
+      return;
+    }
+
+    if (length > NUM_LEDS * COLOURS_PER_LED) {
+      length = NUM_LEDS * COLOURS_PER_LED;
+    }
+
+    const uint32_t frameBytes = ledSpiEncoder::encode(buffer, values, length, WS2812_SPI_BITS);
+    memset(&buffer[frameBytes], 0, RESET_BYTES);
+
+    sending = true;
+    LED_SPI.transfer(buffer, nullptr, frameBytes + RESET_BYTES, onSent);
+  }
+}
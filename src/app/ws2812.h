@@ -0,0 +1,23 @@
+#ifndef OBELISK_WS2812_H
+#define OBELISK_WS2812_H
+
+#include "Particle.h"
+
+/*
+ * Drives a WS2812/SK6812 strip straight from the SPI port's MOSI pin, the frame
+ * is encoded by ledSpiEncoder and sent by DMA so the render thread doesn't wait
+ * on it.
+ */
+namespace ws2812 {
+  void setup();
+
+  /**
+   * Encode and start sending a frame. A frame that arrives while the last is still
+   * being sent is dropped rather than waited for.
+   * @param values LED bytes in the strip's colour order
+   * @param length number of bytes, at most NUM_LEDS * COLOURS_PER_LED
+   */
+  void send(const uint8_t *values, uint32_t length);
+}
+
+#endif
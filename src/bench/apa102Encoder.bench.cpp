@@ -0,0 +1,28 @@
+#include "bench.h"
+#include "apa102Encoder.h"
+
+#define BENCH_NUM_LEDS 300
+
+static uint8_t values[BENCH_NUM_LEDS * 3];
+static uint8_t output[apa102Encoder::encodedLength(BENCH_NUM_LEDS)];
+static uint8_t brightness;
+
+static void encode() {
+  apa102Encoder::encode(output, values, BENCH_NUM_LEDS, brightness);
+  benchKeep(output);
+}
+
+//full brightness and dimmed, which scales every channel through the reciprocal table
+void benchApa102Encoder() {
+  for (uint32_t i=0; i<sizeof(values); i++) {
+    values[i] = (uint8_t)(i * 37);
+  }
+
+  benchGroup("apa102Encoder, 300 LEDs");
+
+  brightness = 255;
+  benchPrint("brightness 255", benchTime(encode, 10000, 7), BENCH_NUM_LEDS, "LED");
+
+  brightness = 64;
+  benchPrint("brightness 64", benchTime(encode, 10000, 7), BENCH_NUM_LEDS, "LED");
+}
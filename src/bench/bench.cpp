@@ -0,0 +1,42 @@
+#include "bench.h"
+#include <chrono>
+#include <stdio.h>
+
+static const void * volatile sink;
+
+double benchTime(void (*fn)(), uint32_t calls, uint32_t runs) {
+  double best = 0;
+
+  for (uint32_t run=0; run<runs; run++) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i=0; i<calls; i++) {
+      fn();
+    }
+
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    const double ns = elapsed.count() / calls;
+
+    if (run == 0 || ns < best) {
+      best = ns;
+    }
+  }
+
+  return best;
+}
+
+void benchPrint(const char *name, double ns, uint32_t units, const char *unit) {
+  if (units > 0) {
+    printf("  %-28s %10.1f ns %8.2f ns/%s\n", name, ns, ns / units, unit);
+  } else {
+    printf("  %-28s %10.1f ns\n", name, ns);
+  }
+}
+
+void benchGroup(const char *name) {
+  printf("%s\n", name);
+}
+
+void benchKeep(const void *result) {
+  sink = result;
+}
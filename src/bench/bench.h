@@ -0,0 +1,35 @@
+#ifndef OBELISK_BENCH_H
+#define OBELISK_BENCH_H
+
+#include <stdint.h>
+
+/*
+ * Host benchmarks, built with the same flags as the unit tests. Each case is
+ * timed over a run of calls and the best of several runs is reported, so the
+ * figures are the host's and only a guide to relative costs on the device.
+ */
+
+/**
+ * Time fn over runs of calls
+ * @return the best run's time per call in ns
+ */
+double benchTime(void (*fn)(), uint32_t calls, uint32_t runs);
+
+/* Print a case's time per call and, if units > 0, per unit, eg ns per LED */
+void benchPrint(const char *name, double ns, uint32_t units = 0, const char *unit = "");
+
+/* Print the heading for a group of cases */
+void benchGroup(const char *name);
+
+/* Hand a result on so the compiler can't drop the work that produced it */
+void benchKeep(const void *result);
+
+void benchRender();
+void benchColourParse();
+void benchStrToInt();
+void benchFixture();
+void benchLedSpiEncoder();
+void benchApa102Encoder();
+void benchDmxMerge();
+
+#endif
@@ -0,0 +1,13 @@
+#include "bench.h"
+
+int main() {
+  benchRender();
+  benchColourParse();
+  benchStrToInt();
+  benchFixture();
+  benchLedSpiEncoder();
+  benchApa102Encoder();
+  benchDmxMerge();
+
+  return 0;
+}
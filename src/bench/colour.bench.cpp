@@ -0,0 +1,36 @@
+#include "bench.h"
+#include "colour.h"
+#include <stdlib.h>
+
+static const char *const HEX_COLOUR = "#1A2b3C";
+static const String HEX_COLOUR_STRING = HEX_COLOUR;
+static Colour parsed;
+
+static void parseChars() {
+  Colour::parse(HEX_COLOUR, &parsed);
+  benchKeep(&parsed);
+}
+
+static void parseString() {
+  Colour::parse(HEX_COLOUR_STRING, &parsed);
+  benchKeep(&parsed);
+}
+
+//the shape of the parser before the nibble table, a substring per channel
+static void parseSubstrings() {
+  const String red = HEX_COLOUR_STRING.substring(1, 3);
+  const String green = HEX_COLOUR_STRING.substring(3, 5);
+  const String blue = HEX_COLOUR_STRING.substring(5, 7);
+
+  parsed = Colour(strtoul(red.c_str(), nullptr, 16),
+                  strtoul(green.c_str(), nullptr, 16),
+                  strtoul(blue.c_str(), nullptr, 16));
+  benchKeep(&parsed);
+}
+
+void benchColourParse() {
+  benchGroup("Colour::parse, '#rrggbb'");
+  benchPrint("const char*", benchTime(parseChars, 1000000, 5));
+  benchPrint("String", benchTime(parseString, 1000000, 5));
+  benchPrint("substring per channel", benchTime(parseSubstrings, 1000000, 5));
+}
@@ -0,0 +1,93 @@
+#include "bench.h"
+#include "config.h"
+#include "dmxMerge.h"
+#include <stdio.h>
+
+//DmxMerge is sized at compile time by NUM_LEDS
+#define BENCH_LENGTH (NUM_LEDS * COLOURS_PER_LED)
+#define BENCH_THIRD (BENCH_LENGTH / 3)
+
+static const merge_range_t RANGES[] = {
+  { .first = 0, .count = BENCH_THIRD, .mode = mergeInput },
+  { .first = BENCH_THIRD, .count = BENCH_THIRD, .mode = mergeHtp },
+  { .first = 2 * BENCH_THIRD, .count = BENCH_LENGTH - 2 * BENCH_THIRD, .mode = mergeLtp },
+};
+
+static uint8_t pattern[BENCH_LENGTH];
+static uint8_t inputs[2][BENCH_LENGTH];
+static uint8_t output[BENCH_LENGTH];
+static uint32_t frame;
+
+static DmxMerge *dmxMerge;
+
+//a slot at a time reference, switching on each slot's mode
+static MergeMode modes[BENCH_LENGTH];
+static bool inputOwns[BENCH_LENGTH];
+static uint8_t lastInput[BENCH_LENGTH];
+static uint8_t lastPattern[BENCH_LENGTH];
+
+static void mergeBytewise(uint8_t *output, const uint8_t *pattern, const uint8_t *input, uint32_t length) {
+  for (uint32_t i=0; i<length; i++) {
+    switch (modes[i]) {
+      case mergePattern:
+        output[i] = pattern[i];
+        break;
+
+      case mergeInput:
+        output[i] = input[i];
+        break;
+
+      case mergeHtp:
+        output[i] = input[i] >= pattern[i] ? input[i] : pattern[i];
+        break;
+
+      case mergeLtp:
+        if (input[i] != lastInput[i]) {
+          inputOwns[i] = true;
+        } else if (pattern[i] != lastPattern[i]) {
+          inputOwns[i] = false;
+        }
+
+        lastInput[i] = input[i];
+        lastPattern[i] = pattern[i];
+        output[i] = inputOwns[i] ? input[i] : pattern[i];
+        break;
+    }
+  }
+}
+
+//the console alternates between two frames so latest takes precedence sees changes
+static void mergeWords() {
+  dmxMerge->merge(output, pattern, inputs[frame++ & 1], BENCH_LENGTH);
+  benchKeep(output);
+}
+
+static void mergeSlots() {
+  mergeBytewise(output, pattern, inputs[frame++ & 1], BENCH_LENGTH);
+  benchKeep(output);
+}
+
+void benchDmxMerge() {
+  char heading[64];
+
+  for (uint32_t i=0; i<BENCH_LENGTH; i++) {
+    pattern[i] = (uint8_t)(i * 37);
+    inputs[0][i] = (uint8_t)(i * 53);
+    inputs[1][i] = (uint8_t)(i * 53 + (i & 1));
+  }
+
+  for (uint32_t i=0; i<sizeof(RANGES) / sizeof(RANGES[0]); i++) {
+    for (uint32_t slot=RANGES[i].first; slot<RANGES[i].first + RANGES[i].count; slot++) {
+      modes[slot] = RANGES[i].mode;
+    }
+  }
+
+  dmxMerge = new DmxMerge(RANGES, sizeof(RANGES) / sizeof(RANGES[0]));
+
+  snprintf(heading, sizeof(heading), "DmxMerge, %u values over input, HTP and LTP ranges", BENCH_LENGTH);
+  benchGroup(heading);
+  benchPrint("word at a time", benchTime(mergeWords, 100000, 20), BENCH_LENGTH, "slot");
+  benchPrint("slot at a time switch", benchTime(mergeSlots, 100000, 20), BENCH_LENGTH, "slot");
+
+  delete dmxMerge;
+}
@@ -0,0 +1,51 @@
+#include "bench.h"
+#include "config.h"
+#include "fixture.h"
+#include "pixelMap.h"
+
+#define BENCH_NUM_LEDS 64
+
+static const fixture_profile_t *const PROFILES[] = {
+  &fixture::PROFILE_RGB,
+  &fixture::PROFILE_GRB,
+  &fixture::PROFILE_RGBW,
+  &fixture::PROFILE_RGBA,
+  &fixture::PROFILE_DIMMER_RGB,
+  &fixture::PROFILE_RGB16,
+};
+
+static const pixel_map_config_t CONFIG_PIXEL_MAP = {
+  .numLeds = BENCH_NUM_LEDS,
+};
+
+static uint8_t values[BENCH_NUM_LEDS * COLOURS_PER_LED];
+static uint8_t output[BENCH_NUM_LEDS * FIXTURE_SLOTS_MAX];
+static uint16_t map[BENCH_NUM_LEDS];
+static const fixture_profile_t *profile;
+
+static void applyPixelMap() {
+  pixelMap::apply(output, values, map, BENCH_NUM_LEDS, orderGrb);
+  benchKeep(output);
+}
+
+static void packProfile() {
+  fixture::pack(output, values, map, BENCH_NUM_LEDS, profile);
+  benchKeep(output);
+}
+
+//a frame through each profile's packer, against the plain gather pixel strips use
+void benchFixture() {
+  for (uint32_t i=0; i<sizeof(values); i++) {
+    values[i] = (uint8_t)(i * 37);
+  }
+
+  pixelMap::build(map, &CONFIG_PIXEL_MAP);
+
+  benchGroup("fixture profiles, 64 LEDs");
+  benchPrint("pixelMap::apply", benchTime(applyPixelMap, 100000, 7), BENCH_NUM_LEDS, "pixel");
+
+  for (uint32_t i=0; i<sizeof(PROFILES) / sizeof(PROFILES[0]); i++) {
+    profile = PROFILES[i];
+    benchPrint(profile->name, benchTime(packProfile, 100000, 7), BENCH_NUM_LEDS, "pixel");
+  }
+}
@@ -0,0 +1,60 @@
+#include "bench.h"
+#include "ledSpiEncoder.h"
+#include <string.h>
+
+//300 LEDs
+#define BENCH_BYTES 900
+
+static uint8_t values[BENCH_BYTES];
+static uint8_t output[BENCH_BYTES * 4];
+
+//bit at a time reference, as in the encoder's tests, a 0 is a single high SPI bit and a 1 is spiBits - 1
+static void referenceEncode(uint8_t *out, const uint8_t *values, uint32_t length, uint8_t spiBits) {
+  uint32_t bit = 0;
+
+  memset(out, 0, length * spiBits);
+
+  for (uint32_t i=0; i < length; i++) {
+    for (int32_t b=7; b >= 0; b--) {
+      const uint32_t high = (values[i] >> b) & 1 ? spiBits - 1 : 1;
+
+      for (uint32_t j=0; j < spiBits; j++, bit++) {
+        if (j < high) {
+          out[bit / 8] |= 0x80 >> (bit % 8);
+        }
+      }
+    }
+  }
+}
+
+static void encode3() {
+  ledSpiEncoder::encode3(output, values, BENCH_BYTES);
+  benchKeep(output);
+}
+
+static void encode4() {
+  ledSpiEncoder::encode4(output, values, BENCH_BYTES);
+  benchKeep(output);
+}
+
+static void reference3() {
+  referenceEncode(output, values, BENCH_BYTES, 3);
+  benchKeep(output);
+}
+
+static void reference4() {
+  referenceEncode(output, values, BENCH_BYTES, 4);
+  benchKeep(output);
+}
+
+void benchLedSpiEncoder() {
+  for (uint32_t i=0; i<BENCH_BYTES; i++) {
+    values[i] = (uint8_t)(i * 37);
+  }
+
+  benchGroup("ledSpiEncoder, 900 bytes (300 LEDs)");
+  benchPrint("encode3", benchTime(encode3, 10000, 7), BENCH_BYTES, "byte");
+  benchPrint("encode3, bit at a time", benchTime(reference3, 1000, 7), BENCH_BYTES, "byte");
+  benchPrint("encode4", benchTime(encode4, 10000, 7), BENCH_BYTES, "byte");
+  benchPrint("encode4, bit at a time", benchTime(reference4, 1000, 7), BENCH_BYTES, "byte");
+}
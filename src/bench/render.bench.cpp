@@ -0,0 +1,67 @@
+#include "bench.h"
+#include "config.h"
+#include "colour.h"
+#include "colours.h"
+#include "ledStripDriver.h"
+
+#define BENCH_NUM_LEDS 150
+
+static uint8_t values[BENCH_NUM_LEDS * COLOURS_PER_LED];
+static Colour colourOn = COLOUR_BLUE;
+static Colour colourOff = COLOUR_BLACK;
+static Colour colourRain = COLOUR_WHITE;
+static Colour colourWarning = COLOUR_RED;
+
+static void writeNothing(uint8_t *values, uint32_t length) {}
+
+static led_strip_config_t config = {
+  .numLeds = BENCH_NUM_LEDS,
+  .writeValueFn = writeNothing,
+  .resolutionMs = TIMER_RESOLUTION_MS,
+};
+
+static LedStripDriver *driver;
+static led_strip_state_t state;
+
+static void renderFrame() {
+  driver->render(&state, values);
+  benchKeep(values);
+}
+
+static void benchPattern(const char *name) {
+  driver->initState(&state);
+  benchPrint(name, benchTime(renderFrame, 20000, 4), BENCH_NUM_LEDS, "LED");
+}
+
+//a frame of each pattern that draws per LED, from the pattern's first frame on
+void benchRender() {
+  driver = new LedStripDriver(&config);
+
+  benchGroup("render, 150 LEDs");
+
+  driver->pattern(Pattern::colour)->colourOn(&colourOn);
+  benchPattern("colour");
+
+  driver->pattern(Pattern::snake)
+    ->length(10)
+    ->snakeDirection(Direction::forward)
+    ->colourOn(&colourOn)
+    ->colourOff(&colourOff);
+  benchPattern("snake");
+
+  driver->pattern(Pattern::weather)
+    ->colourOn(&colourOn)
+    ->colourOff(&colourOff)
+    ->tempFadeInterval(4)
+    ->rainBandHeight(2)
+    ->rainBandSpacing(4)
+    ->rainBandIncrementDelay(100)
+    ->rainBandColour(&colourRain)
+    ->warningColour(&colourWarning)
+    ->warningFadeIn(500)
+    ->warningFadeOut(500)
+    ->warningOffDwell(200);
+  benchPattern("weather");
+
+  delete driver;
+}
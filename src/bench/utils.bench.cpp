@@ -0,0 +1,62 @@
+#include "bench.h"
+#include "utils.h"
+#include <stdio.h>
+
+static const char *const NUMBERS[] = {
+  "7", "42", "1234", "12345", "123456", "1234567", "4294967295",
+};
+
+static String number;
+static uint32_t value;
+
+//strToInt() before the forward parser, the String taken by value and walked backwards
+static int32_t strToIntBackwards(uint32_t *value, String str) {
+  uint32_t len = str.length();
+  uint32_t exp = 0;
+
+  *value = 0;
+
+  if (len == 0) {
+    return -1;
+  }
+
+  for (int32_t i=(len - 1); i >= 0; i--) {
+    char c = str.charAt(i);
+
+    if (c < '0' || c > '9') {
+      return -1;
+    }
+
+    *value += ((uint32_t)c - '0') * (exp > 0 ? exp : 1);
+    exp = exp > 0 ? exp*10 : 10;
+  }
+
+  return 0;
+}
+
+static void parseForward() {
+  strToInt(&value, number);
+  benchKeep(&value);
+}
+
+static void parseBackwards() {
+  strToIntBackwards(&value, number);
+  benchKeep(&value);
+}
+
+//up to the 10 digits the argument schemas allow
+void benchStrToInt() {
+  char name[32];
+
+  benchGroup("strToInt, by digits");
+
+  for (uint32_t i=0; i<sizeof(NUMBERS) / sizeof(NUMBERS[0]); i++) {
+    number = NUMBERS[i];
+
+    snprintf(name, sizeof(name), "%u digits", (unsigned)number.length());
+    benchPrint(name, benchTime(parseForward, 1000000, 5));
+
+    snprintf(name, sizeof(name), "%u digits, backwards", (unsigned)number.length());
+    benchPrint(name, benchTime(parseBackwards, 1000000, 5));
+  }
+}
@@ -3,4 +3,16 @@
 
 #include "String.h"
 
+/* The tests run on one thread, so locking is a no-op */
+class RecursiveMutex {
+public:
+  void lock() {}
+  void unlock() {}
+  bool try_lock() { return true; }
+};
+
+/* Like Device OS's, runs the block with the lock held. Don't return from inside it. */
+#define WITH_LOCK(mutex) \
+  for (bool __locked##mutex = ((mutex).lock(), true); __locked##mutex; (mutex).unlock(), __locked##mutex = false)
+
 #endif
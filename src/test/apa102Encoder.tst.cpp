@@ -0,0 +1,84 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "apa102Encoder.h"
+#include <math.h>
+
+#define MAX_LEDS 20
+
+static uint8_t output[apa102Encoder::encodedLength(MAX_LEDS) + 1];
+
+TEST_GROUP(Apa102EncoderTestGroup)
+{
+  void setup() {
+    memset(output, 0xAA, sizeof(output));
+  }
+};
+
+TEST(Apa102EncoderTestGroup, writesStartFrameLedFramesAndEndFrame)
+{
+  const uint8_t values[] = {255, 255, 255, 0, 0, 0};
+  const uint8_t expected[] = {
+    0, 0, 0, 0,
+    0xFF, 255, 255, 255,
+    0xE0, 0, 0, 0,
+    0, 0, 0, 0, 0,
+  };
+
+  LONGS_EQUAL(sizeof(expected), apa102Encoder::encode(output, values, 2, 255));
+  MEMCMP_EQUAL(expected, output, sizeof(expected));
+  BYTES_EQUAL(0xAA, output[sizeof(expected)]);
+}
+
+TEST(Apa102EncoderTestGroup, endFrameGrowsWithLeds)
+{
+  LONGS_EQUAL(5, apa102Encoder::endFrameLength(16));
+  LONGS_EQUAL(6, apa102Encoder::endFrameLength(17));
+  LONGS_EQUAL(4 + 17 * 4 + 6, apa102Encoder::encodedLength(17));
+}
+
+TEST(Apa102EncoderTestGroup, dimColoursUseLowGlobalBrightnessAndFullChannelRange)
+{
+  const uint8_t values[] = {2, 1, 0};
+
+  apa102Encoder::encode(output, values, 1, 255);
+
+  //1/31 global, channels scaled up from 2/255 and 1/255
+  BYTES_EQUAL(0xE1, output[4]);
+  BYTES_EQUAL(62, output[5]);
+  BYTES_EQUAL(31, output[6]);
+  BYTES_EQUAL(0, output[7]);
+}
+
+TEST(Apa102EncoderTestGroup, masterBrightnessLowersGlobalBrightness)
+{
+  const uint8_t values[] = {255, 255, 255};
+
+  apa102Encoder::encode(output, values, 1, 128);
+
+  BYTES_EQUAL(0xE0 | 16, output[4]);
+  BYTES_EQUAL(248, output[5]);
+}
+
+TEST(Apa102EncoderTestGroup, showsEveryLevelAtTheLowestGlobalBrightness)
+{
+  const uint8_t BRIGHTNESS[] = {255, 200, 128, 64, 17, 1};
+
+  for (uint32_t b=0; b < sizeof(BRIGHTNESS); b++) {
+    for (uint32_t level=0; level < 256; level++) {
+      const uint8_t values[] = {(uint8_t)level, (uint8_t)(level / 2), 0};
+
+      apa102Encoder::encode(output, values, 1, BRIGHTNESS[b]);
+
+      const uint32_t global = output[4] & 0x1F;
+      const double wanted = level * BRIGHTNESS[b] / (255.0 * 255.0);
+      const double shown = global * output[5] / (31.0 * 255.0);
+
+      BYTES_EQUAL(0xE0, output[4] & 0xE0);
+      //within two steps of the channel at this global
+      CHECK(fabs(shown - wanted) <= 2.0 * global / (31.0 * 255.0));
+      //and the global one lower couldn't have shown it
+      CHECK(global == 0 || (global - 1) * 255.0 * 255.0 < level * BRIGHTNESS[b] * 31.0);
+    }
+  }
+}
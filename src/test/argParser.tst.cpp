@@ -96,6 +96,20 @@ TEST(ArgParserTestGroup, returnsErrorForNumberAboveMaximum)
               parseAndValidateArgs(output, (ArgConfig*)&ARG_CONFIG_STROBE, "1001,#FF0000"));
 }
 
+TEST(ArgParserTestGroup, returnsErrorForNumberThatWrapsIntoRange)
+{
+  //2^32 + 500 used to wrap round to 500
+  LONGS_EQUAL(RET_VAL_INVALID_ARG,
+              parseAndValidateArgs(output, (ArgConfig*)&ARG_CONFIG_STROBE, "4294967796,#FF0000"));
+}
+
+TEST(ArgParserTestGroup, returnsErrorForNumberAboveInt32Max)
+{
+  //used to be read back as a negative int32_t
+  LONGS_EQUAL(RET_VAL_INVALID_ARG,
+              parseAndValidateArgs(output, (ArgConfig*)&ARG_CONFIG_STROBE, "4294967295,#FF0000"));
+}
+
 TEST(ArgParserTestGroup, writesParsedArgsToOutputCorrectly)
 {
   const String ARG_PERIOD("1000");
@@ -107,3 +121,61 @@ TEST(ArgParserTestGroup, writesParsedArgsToOutputCorrectly)
   STRCMP_EQUAL(ARG_PERIOD, output[0]);
   STRCMP_EQUAL(ARG_COLOUR, output[1]);
 }
+
+TEST(ArgParserTestGroup, parseArgsConvertsNumbersAndColours)
+{
+  uint32_t values[2];
+
+  LONGS_EQUAL(RET_VAL_SUC,
+              parseArgs(values, &ARG_CONFIG_STROBE, "250,#12AB3C"));
+
+  LONGS_EQUAL(250, values[0]);
+  LONGS_EQUAL(0x12AB3C, values[1]);
+}
+
+TEST(ArgParserTestGroup, parseArgsReturnsErrorForInvalidArgs)
+{
+  uint32_t values[2];
+
+  LONGS_EQUAL(RET_VAL_INVALID_ARG,
+              parseArgs(values, &ARG_CONFIG_STROBE, "1001,#12AB3C"));
+}
+
+TEST(ArgParserTestGroup, packedSizeUsesFewestBytesForNumberRange)
+{
+  const ArgInfo byteInfo = { .type = ARG_TYPE_NUMBER, .min = 0, .max = 255 };
+  const ArgInfo shortInfo = { .type = ARG_TYPE_NUMBER, .min = 0, .max = 256 };
+  const ArgInfo longInfo = { .type = ARG_TYPE_NUMBER, .min = 0, .max = 65536 };
+
+  LONGS_EQUAL(1, packedSize(&byteInfo));
+  LONGS_EQUAL(2, packedSize(&shortInfo));
+  LONGS_EQUAL(4, packedSize(&longInfo));
+  LONGS_EQUAL(3, packedSize(&ARG_INFO_COLOUR));
+}
+
+TEST(ArgParserTestGroup, packArgsWritesPackedValues)
+{
+  const uint32_t values[] = {1000, 0x12AB3C};
+  uint8_t packed[8];
+
+  LONGS_EQUAL(5, packArgs(packed, &ARG_CONFIG_STROBE, values));
+
+  BYTES_EQUAL(0xE8, packed[0]);
+  BYTES_EQUAL(0x03, packed[1]);
+  BYTES_EQUAL(0x3C, packed[2]);
+  BYTES_EQUAL(0xAB, packed[3]);
+  BYTES_EQUAL(0x12, packed[4]);
+}
+
+TEST(ArgParserTestGroup, unpackArgsRestoresPackedValues)
+{
+  const uint32_t values[] = {999, 0xFFFFFF};
+  uint32_t unpacked[2];
+  uint8_t packed[8];
+
+  packArgs(packed, &ARG_CONFIG_STROBE, values);
+
+  LONGS_EQUAL(5, unpackArgs(unpacked, &ARG_CONFIG_STROBE, packed));
+  LONGS_EQUAL(999, unpacked[0]);
+  LONGS_EQUAL(0xFFFFFF, unpacked[1]);
+}
@@ -0,0 +1,184 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "clockSync.h"
+
+#define TICK_MS 25
+#define SIM_DEVICES 4
+
+/*
+ * A unit whose local millisecond counter runs fast or slow against true time.
+ * The reference is polled every tick, as on the device, and a sample is taken
+ * when its seconds count changes.
+ */
+typedef struct {
+  int32_t skewPpm;
+  uint32_t bootMs;    /* true time the unit was powered on */
+  uint32_t tickPhaseMs;
+  ClockSync clock;
+  uint64_t lastSecond;
+} sim_device_t;
+
+static uint32_t localTime(sim_device_t *device, uint64_t trueMs) {
+  const int64_t upMs = (int64_t)trueMs - device->bootMs;
+
+  return (uint32_t)(upMs + (upMs * device->skewPpm) / 1000000);
+}
+
+static void tick(sim_device_t *device, uint64_t trueMs) {
+  const uint64_t second = trueMs / 1000;
+
+  if (second != device->lastSecond) {
+    device->lastSecond = second;
+    device->clock.sample(localTime(device, trueMs), second * 1000);
+  }
+}
+
+static int64_t clockError(sim_device_t *device, uint64_t trueMs) {
+  return (int64_t)device->clock.now(localTime(device, trueMs)) - (int64_t)trueMs;
+}
+
+static int64_t absolute(int64_t value) {
+  return value < 0 ? -value : value;
+}
+
+static sim_device_t devices[SIM_DEVICES];
+
+/* Run all devices until endMs, returning the worst error between any two of their clocks from fromMs */
+static int64_t simulate(uint64_t startMs, uint64_t endMs, uint64_t fromMs) {
+  int64_t worst = 0;
+
+  for (uint64_t t=startMs; t<endMs; t++) {
+    int64_t minError = INT32_MAX;
+    int64_t maxError = INT32_MIN;
+    bool ticked = false;
+
+    for (uint32_t i=0; i<SIM_DEVICES; i++) {
+      if (localTime(&devices[i], t) % TICK_MS == devices[i].tickPhaseMs) {
+        tick(&devices[i], t);
+        ticked = true;
+      }
+    }
+
+    if (!ticked || t < fromMs) {
+      continue;
+    }
+
+    for (uint32_t i=0; i<SIM_DEVICES; i++) {
+      const int64_t error = clockError(&devices[i], t);
+
+      minError = error < minError ? error : minError;
+      maxError = error > maxError ? error : maxError;
+    }
+
+    //this is the phase error between patterns started at the same shared time
+    worst = maxError - minError > worst ? maxError - minError : worst;
+  }
+
+  return worst;
+}
+
+static const uint64_t START_MS = 1700000000000ULL;
+
+TEST_GROUP(ClockSyncTestGroup)
+{
+  ClockSync *clock;
+
+  void setup() {
+    const int32_t SKEWS_PPM[SIM_DEVICES] = { 40, -60, 200, -150 };
+    const uint32_t BOOTS_MS[SIM_DEVICES] = { 0, 123457, 5003, 987651 };
+
+    for (uint32_t i=0; i<SIM_DEVICES; i++) {
+      devices[i].skewPpm = SKEWS_PPM[i];
+      devices[i].bootMs = (uint32_t)(START_MS - 1000000) + BOOTS_MS[i];
+      devices[i].tickPhaseMs = (i * 7) % TICK_MS;
+      devices[i].clock.reset();
+      devices[i].lastSecond = 0;
+    }
+
+    clock = new ClockSync();
+  }
+
+  void teardown() {
+    delete clock;
+  }
+};
+
+TEST(ClockSyncTestGroup, runsOnLocalTimeUntilLocked)
+{
+  CHECK(!clock->isLocked());
+  CHECK(clock->now(1234) == 1234);
+}
+
+TEST(ClockSyncTestGroup, firstSampleStepsToReference)
+{
+  CHECK(clock->sample(1000, START_MS));
+  CHECK(clock->isLocked());
+  CHECK(clock->now(1500) == START_MS + 500);
+}
+
+TEST(ClockSyncTestGroup, slewsSmallErrors)
+{
+  clock->sample(1000, START_MS);
+
+  CHECK(!clock->sample(2000, START_MS + 1010));
+  CHECK(clock->now(2000) > START_MS + 1000);
+  CHECK(clock->now(2000) < START_MS + 1010);
+}
+
+TEST(ClockSyncTestGroup, measuresRateOverAnchorSpan)
+{
+  clock->sample(0, START_MS);
+  clock->sample(CLOCK_SYNC_RATE_SPAN_MIN_MS / 2, START_MS + CLOCK_SYNC_RATE_SPAN_MIN_MS / 2 + 3);
+
+  LONGS_EQUAL(0, clock->getRatePpm());
+
+  clock->sample(CLOCK_SYNC_RATE_SPAN_MIN_MS, START_MS + CLOCK_SYNC_RATE_SPAN_MIN_MS + 6);
+
+  LONGS_EQUAL(100, clock->getRatePpm());
+}
+
+TEST(ClockSyncTestGroup, stepsLargeErrors)
+{
+  clock->sample(1000, START_MS);
+
+  CHECK(clock->sample(2000, START_MS + 5000));
+  CHECK(clock->now(2000) == START_MS + 5000);
+}
+
+TEST(ClockSyncTestGroup, neverRunsBackwards)
+{
+  clock->sample(1000, START_MS);
+  uint64_t before = clock->now(2000);
+
+  clock->sample(2000, START_MS + 900);
+
+  CHECK(clock->now(2000) >= before);
+}
+
+TEST(ClockSyncTestGroup, startOfDayIsMidnight)
+{
+  CHECK(ClockSync::startOfDay(MS_PER_DAY * 3 + 1234) == MS_PER_DAY * 3);
+}
+
+TEST(ClockSyncTestGroup, tracksSkewedLocalClock)
+{
+  simulate(START_MS, START_MS + 1200000, START_MS);
+
+  //rate is measured between samples jittered by up to a tick, over 20 minutes
+  for (uint32_t i=0; i<SIM_DEVICES; i++) {
+    CHECK_TEXT(absolute(devices[i].clock.getRatePpm() + devices[i].skewPpm) <= 25,
+               "rate not locked to skew");
+  }
+}
+
+TEST(ClockSyncTestGroup, skewedUnitsConvergeInPhase)
+{
+  //units boot at different times so start far apart, then lock on the first second boundary and stay within
+  //a couple of ticks, as each samples the reference up to a tick late
+  int64_t unlocked = simulate(START_MS, START_MS + 900, START_MS);
+  int64_t locked = simulate(START_MS + 900, START_MS + 600000, START_MS + 2000);
+
+  CHECK_TEXT(unlocked > 1000, "units should start out of phase");
+  CHECK_TEXT(locked < 2 * TICK_MS, "phase error not bounded");
+}
@@ -24,6 +24,35 @@ static int registerFunction(String name, int (CloudFunctions::*fn)(String), Clou
 
 static void writeLedValues(uint8_t *values, uint32_t length) {}
 
+static playlist_store_t savedPlaylist;
+static uint32_t fakeNow;
+
+static uint32_t fakeClock() {
+  return fakeNow;
+}
+
+static void onPlaylistChange(const playlist_store_t *store) {
+  savedPlaylist = *store;
+}
+
+static schedule_store_t savedSchedule;
+
+static void onScheduleChange(const schedule_store_t *store) {
+  savedSchedule = *store;
+}
+
+static void onPatternChange(uint32_t transitionMs, uint32_t startTime) {
+  mock().actualCall("onPatternChange")
+    .withParameter("transitionMs", transitionMs)
+    .withParameter("startTime", startTime);
+}
+
+static Pattern patternWhenNotified;
+
+static void recordPattern(uint32_t transitionMs, uint32_t startTime) {
+  patternWhenNotified = ledStripDriver->getPattern();
+}
+
 static const led_strip_config_t CONFIG_LED_STRIP = {
     .numLeds = NUM_LEDS,
     .writeValueFn = writeLedValues,
@@ -84,6 +113,21 @@ TEST(CloudFunctionsTestGroup, registersFunctions)
     .withParameter("fn", (void*)&CloudFunctions::weather)
     .withParameter("cls", cloudFunctions);
 
+  mock().expectOneCall("registerFunction")
+    .withParameter("name", "transition")
+    .withParameter("fn", (void*)&CloudFunctions::transition)
+    .withParameter("cls", cloudFunctions);
+
+  mock().expectOneCall("registerFunction")
+    .withParameter("name", "playlist")
+    .withParameter("fn", (void*)&CloudFunctions::playlist)
+    .withParameter("cls", cloudFunctions);
+
+  mock().expectOneCall("registerFunction")
+    .withParameter("name", "schedule")
+    .withParameter("fn", (void*)&CloudFunctions::schedule)
+    .withParameter("cls", cloudFunctions);
+
   cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
   delete cloudFunctions;
 }
@@ -102,8 +146,8 @@ TEST(CloudFunctionsTestGroup, blinkPassesCorrectArgsToLedDriver)
 {
   const uint32_t PERIOD_MS = 1000;
   const uint8_t DUTY_CYCLE = 50;
-  Colour COLOUR_ON = Colour("#FF0000");
-  Colour COLOUR_OFF = Colour("#000000");
+  Colour COLOUR_ON = Colour(0xFF, 0x00, 0x00);
+  Colour COLOUR_OFF = Colour(0x00, 0x00, 0x00);
   char args[ARGS_LEN_MAX];
 
   sprintf(args, "%d,%d,%s,%s",
@@ -136,7 +180,7 @@ TEST(CloudFunctionsTestGroup, colourReturnsSuccessForValidInput)
 
 TEST(CloudFunctionsTestGroup, colourPassesCorrectArgsToLedDriver)
 {
-  Colour COLOUR = Colour("#001800");
+  Colour COLOUR = Colour(0x00, 0x18, 0x00);
 
   cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
   cloudFunctions->colour(COLOUR.toString());
@@ -169,7 +213,7 @@ TEST(CloudFunctionsTestGroup, strobeReturnsErrorForInvalidInput)
 TEST(CloudFunctionsTestGroup, strobePassesCorrectArgsToLedDriver)
 {
   const uint32_t PERIOD_MS = 1000;
-  Colour COLOUR = Colour("#FF0000");
+  Colour COLOUR = Colour(0xFF, 0x00, 0x00);
   char args[ARGS_LEN_MAX];
 
   sprintf(args, "%d,%s", PERIOD_MS, COLOUR.toString().c_str());
@@ -207,8 +251,8 @@ TEST(CloudFunctionsTestGroup, gradientReturnsErrorForInvalidInput)
 
 TEST(CloudFunctionsTestGroup, gradientPassesCorrectArgsToLedDriver)
 {
-  Colour COLOUR_START = Colour("#FF0000");
-  Colour COLOUR_END = Colour("#0000FF");
+  Colour COLOUR_START = Colour(0xFF, 0x00, 0x00);
+  Colour COLOUR_END = Colour(0x00, 0x00, 0xFF);
   char args[ARGS_LEN_MAX];
 
   sprintf(args, "%s,%s", COLOUR_START.toString().c_str(), COLOUR_END.toString().c_str());
@@ -251,8 +295,8 @@ TEST(CloudFunctionsTestGroup, progressPassesCorrectArgsToLedDriver)
   uint32_t INC_DELAY = 200;
   uint32_t RESET_DELAY = 3000;
   Direction DIRECTION = Direction::reverse;
-  Colour COLOUR_ON = Colour("#123456");
-  Colour COLOUR_OFF = Colour("#AABBCC");
+  Colour COLOUR_ON = Colour(0x12, 0x34, 0x56);
+  Colour COLOUR_OFF = Colour(0xAA, 0xBB, 0xCC);
   char args[ARGS_LEN_MAX];
 
   sprintf(args, "%d,%d,%d,%d,%d,%d,%s,%s",
@@ -306,8 +350,8 @@ TEST(CloudFunctionsTestGroup, snakePassesCorrectArgsToLedDriver)
   uint32_t PERIOD_MS = 1000;
   uint8_t LENGTH = 5;
   Direction DIRECTION = Direction::reverse;
-  Colour COLOUR_ON = Colour("#9823AF");
-  Colour COLOUR_OFF = Colour("#883322");
+  Colour COLOUR_ON = Colour(0x98, 0x23, 0xAF);
+  Colour COLOUR_OFF = Colour(0x88, 0x33, 0x22);
   char args[ARGS_LEN_MAX];
 
   sprintf(args, "%d,%d,%d,%s,%s",
@@ -353,8 +397,8 @@ TEST(CloudFunctionsTestGroup, pulseReturnsErrorForInvalidInput)
 TEST(CloudFunctionsTestGroup, pulsePassesCorrectArgsToLedDriver)
 {
   uint32_t PERIOD_MS = 1000;
-  Colour COLOUR_ON = Colour("#9823AF");
-  Colour COLOUR_OFF = Colour("#883322");
+  Colour COLOUR_ON = Colour(0x98, 0x23, 0xAF);
+  Colour COLOUR_OFF = Colour(0x88, 0x33, 0x22);
   char args[ARGS_LEN_MAX];
 
   sprintf(args, "%d,%s,%s",
@@ -373,4 +417,417 @@ TEST(CloudFunctionsTestGroup, pulsePassesCorrectArgsToLedDriver)
   delete cloudFunctions;
 }
 
-// TODO reset state before each new pattern
+TEST(CloudFunctionsTestGroup, transitionReturnsSuccessForValidInput)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+
+  LONGS_EQUAL(argParser::RET_VAL_SUC,
+              cloudFunctions->transition("1500"));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, transitionReturnsErrorForInvalidInput)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+
+  LONGS_EQUAL(argParser::RET_VAL_INVALID_ARG,
+              cloudFunctions->transition("60001"));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, notifiesPatternChangeWithTransitionDuration)
+{
+  mock().expectOneCall("onPatternChange")
+    .withParameter("transitionMs", 1500)
+    .withParameter("startTime", 0);
+
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->onPatternChange(onPatternChange);
+  cloudFunctions->transition("1500");
+  cloudFunctions->colour("#FF0000");
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, notifiesPatternChangeWithStartTime)
+{
+  mock().expectOneCall("onPatternChange")
+    .withParameter("transitionMs", 1500)
+    .withParameter("startTime", 1700000000);
+
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->onPatternChange(onPatternChange);
+  cloudFunctions->transition("1500");
+
+  LONGS_EQUAL(argParser::RET_VAL_SUC,
+              cloudFunctions->pulse("1000,#0000FF,#000000,@1700000000"));
+  CHECK(Pattern::pulse == ledStripDriver->getPattern());
+  LONGS_EQUAL(1000, ledStripDriver->getPeriod());
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, notifiesPatternChangeOnceDriverConfigured)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->onPatternChange(recordPattern);
+  cloudFunctions->strobe("100,#FF0000");
+
+  CHECK(Pattern::strobe == patternWhenNotified);
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, returnsErrorForInvalidStartTime)
+{
+  mock().expectNoCall("onPatternChange");
+
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->onPatternChange(onPatternChange);
+
+  LONGS_EQUAL(argParser::RET_VAL_INVALID_ARG,
+              cloudFunctions->colour("#FF0000,@soon"));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, doesNotNotifyPatternChangeForInvalidInput)
+{
+  mock().expectNoCall("onPatternChange");
+
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->onPatternChange(onPatternChange);
+  cloudFunctions->colour("#FF00");
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, colourSetsColourOffToBlack)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->colour("#FF0000");
+
+  STRCMP_EQUAL(COLOUR_BLACK.toString(), ledStripDriver->getColourOff()->toString());
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, playlistReturnsSuccessForValidInput)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+
+  LONGS_EQUAL(argParser::RET_VAL_SUC,
+              cloudFunctions->playlist("colour,1000,0,#FF0000;strobe,2000,500,100,#00FF00"));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, playlistReturnsErrorForUnknownPattern)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+
+  LONGS_EQUAL(argParser::RET_VAL_INVALID_ARG,
+              cloudFunctions->playlist("colour,1000,0,#FF0000;sparkle,2000,500,100"));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, playlistReturnsErrorForInvalidPatternArgs)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+
+  LONGS_EQUAL(argParser::RET_VAL_INVALID_ARG,
+              cloudFunctions->playlist("strobe,2000,500,1,#00FF00"));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, playlistReturnsErrorForMissingDuration)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+
+  LONGS_EQUAL(argParser::RET_VAL_TOO_FEW_ARGS,
+              cloudFunctions->playlist("colour,#FF0000"));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, playlistEntersEntriesOnTick)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->playlist("colour,20,0,#FF0000;strobe,20,0,100,#00FF00");
+
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+
+  CHECK(Pattern::colour == ledStripDriver->getPattern());
+  STRCMP_EQUAL("#FF0000", ledStripDriver->getColourOn()->toString());
+
+  for (uint32_t i=0; i < 20 / TIMER_RESOLUTION_MS; i++) {
+    cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+  }
+
+  CHECK(Pattern::strobe == ledStripDriver->getPattern());
+  LONGS_EQUAL(100, ledStripDriver->getPeriod());
+  STRCMP_EQUAL("#00FF00", ledStripDriver->getColourOn()->toString());
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, playlistEntryUsesItsTransition)
+{
+  mock().expectOneCall("onPatternChange")
+    .withParameter("transitionMs", 750)
+    .withParameter("startTime", 0);
+
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->onPatternChange(onPatternChange);
+  cloudFunctions->playlist("colour,20,750,#FF0000");
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, patternCommandStopsPlaylist)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->playlist("colour,20,0,#FF0000");
+  cloudFunctions->pulse("1000,#0000FF,#000000");
+
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+
+  CHECK(Pattern::pulse == ledStripDriver->getPattern());
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, savedPlaylistCanBeLoaded)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->onPlaylistChange(onPlaylistChange);
+  cloudFunctions->playlist("gradient,20,0,#FF0000,#0000FF");
+  delete cloudFunctions;
+
+  ledStripDriver->pattern(Pattern::colour);
+
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  CHECK(cloudFunctions->loadPlaylist(&savedPlaylist));
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+
+  CHECK(Pattern::gradient == ledStripDriver->getPattern());
+  STRCMP_EQUAL("#0000FF", ledStripDriver->getColourOff()->toString());
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, loadPlaylistRejectsEntryPastUsedBytes)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->onPlaylistChange(onPlaylistChange);
+  cloudFunctions->playlist("gradient,20,0,#FF0000,#0000FF");
+  delete cloudFunctions;
+
+  savedPlaylist.used -= 1;
+
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  CHECK_FALSE(cloudFunctions->loadPlaylist(&savedPlaylist));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, loadPlaylistRejectsInvalidStore)
+{
+  playlist_store_t store;
+  memset(&store, 0xFF, sizeof(store));
+
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+
+  CHECK_FALSE(cloudFunctions->loadPlaylist(&store));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, scheduleReturnsSuccessForValidInput)
+{
+  fakeNow = 1000;
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->wallClock(fakeClock);
+
+  LONGS_EQUAL(argParser::RET_VAL_SUC,
+              cloudFunctions->schedule("colour,2000,0,#FF0000"));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, scheduleReturnsErrorWithoutClock)
+{
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+
+  LONGS_EQUAL(argParser::RET_VAL_INVALID_ARG,
+              cloudFunctions->schedule("colour,2000,0,#FF0000"));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, scheduleReturnsErrorForInvalidTimeOfDay)
+{
+  fakeNow = 1000;
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->wallClock(fakeClock);
+
+  LONGS_EQUAL(argParser::RET_VAL_INVALID_ARG,
+              cloudFunctions->schedule("colour,86400,1,#FF0000"));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, scheduledCommandFiresAtItsTime)
+{
+  fakeNow = 1000;
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->wallClock(fakeClock);
+  cloudFunctions->colour("#0000FF");
+  cloudFunctions->schedule("strobe,1005,0,300,#FF0000");
+
+  fakeNow = 1004;
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+  CHECK(Pattern::colour == ledStripDriver->getPattern());
+
+  fakeNow = 1005;
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+  CHECK(Pattern::strobe == ledStripDriver->getPattern());
+  LONGS_EQUAL(300, ledStripDriver->getPeriod());
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, scheduledCommandStartsAtItsTime)
+{
+  mock().expectOneCall("onPatternChange")
+    .withParameter("transitionMs", 500)
+    .withParameter("startTime", 1005);
+
+  fakeNow = 1000;
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->wallClock(fakeClock);
+  cloudFunctions->schedule("strobe,1005,0,300,#FF0000");
+  cloudFunctions->onPatternChange(onPatternChange);
+
+  fakeNow = 1007;
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, dailyCommandFiresEachDay)
+{
+  const uint32_t MIDNIGHT = 20 * SECONDS_PER_DAY;
+
+  fakeNow = MIDNIGHT + 100;
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->wallClock(fakeClock);
+  cloudFunctions->schedule("colour,50,1,#FF0000");
+
+  //already past today's time, first fires tomorrow
+  cloudFunctions->colour("#0000FF");
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+  STRCMP_EQUAL("#0000FF", ledStripDriver->getColourOn()->toString());
+
+  fakeNow = MIDNIGHT + SECONDS_PER_DAY + 50;
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+  STRCMP_EQUAL("#FF0000", ledStripDriver->getColourOn()->toString());
+
+  cloudFunctions->colour("#0000FF");
+  fakeNow = MIDNIGHT + 2 * SECONDS_PER_DAY + 50;
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+  STRCMP_EQUAL("#FF0000", ledStripDriver->getColourOn()->toString());
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, emptyScheduleClearsCommands)
+{
+  fakeNow = 1000;
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->wallClock(fakeClock);
+  cloudFunctions->colour("#0000FF");
+  cloudFunctions->schedule("colour,1001,0,#FF0000");
+  cloudFunctions->schedule("");
+
+  fakeNow = 2000;
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+  STRCMP_EQUAL("#0000FF", ledStripDriver->getColourOn()->toString());
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, dailyCommandRejectedUntilClockKnown)
+{
+  fakeNow = 0;
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->wallClock(fakeClock);
+
+  LONGS_EQUAL(argParser::RET_VAL_INVALID_ARG,
+              cloudFunctions->schedule("colour,50,1,#FF0000"));
+  LONGS_EQUAL(argParser::RET_VAL_SUC,
+              cloudFunctions->schedule("colour,2000,0,#FF0000"));
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, savedScheduleFiresAfterRestart)
+{
+  memset(&savedSchedule, 0, sizeof(savedSchedule));
+  fakeNow = 1000;
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->wallClock(fakeClock)->onScheduleChange(onScheduleChange);
+  cloudFunctions->schedule("strobe,1005,0,300,#FF0000");
+  delete cloudFunctions;
+
+  LONGS_EQUAL(1, savedSchedule.count);
+
+  //no clock until the time is synced after the restart
+  fakeNow = 0;
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->wallClock(fakeClock);
+  CHECK(cloudFunctions->loadSchedule(&savedSchedule));
+  cloudFunctions->colour("#0000FF");
+
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+  CHECK(Pattern::colour == ledStripDriver->getPattern());
+
+  fakeNow = 1010;
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+  CHECK(Pattern::strobe == ledStripDriver->getPattern());
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, firedCommandIsDroppedFromSavedSchedule)
+{
+  fakeNow = 1000;
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->wallClock(fakeClock)->onScheduleChange(onScheduleChange);
+  cloudFunctions->schedule("colour,1001,0,#FF0000");
+
+  fakeNow = 1001;
+  cloudFunctions->onTick(TIMER_RESOLUTION_MS);
+
+  LONGS_EQUAL(0, savedSchedule.count);
+
+  delete cloudFunctions;
+}
+
+TEST(CloudFunctionsTestGroup, loadScheduleRejectsUnknownCommands)
+{
+  fakeNow = 1000;
+  cloudFunctions = new CloudFunctions(ledStripDriver, &registerFunction);
+  cloudFunctions->wallClock(fakeClock)->onScheduleChange(onScheduleChange);
+  cloudFunctions->schedule("colour,2000,0,#FF0000");
+  savedSchedule.entries[0].command = 0xFF;
+
+  CHECK_FALSE(cloudFunctions->loadSchedule(&savedSchedule));
+
+  delete cloudFunctions;
+}
@@ -5,6 +5,9 @@
 #include "StringFrom.h"
 #include "colour.h"
 #include <stdexcept>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
 
 
 TEST_GROUP(ColourTestGroup)
@@ -14,50 +17,153 @@ TEST_GROUP(ColourTestGroup)
   }
 };
 
-TEST(ColourTestGroup, isValidReturnsFalseForInvalidString)
+static Colour parsed(const char *value) {
+  Colour colour;
+  Colour::parse(value, &colour);
+  return colour;
+}
+
+TEST(ColourTestGroup, parseReturnsFalseForInvalidString)
+{
+  Colour colour;
+  CHECK_FALSE(Colour::parse("saohetu", &colour));
+}
+
+TEST(ColourTestGroup, parseReturnsFalseForInvalidLength)
 {
-  Colour colour = Colour("saohetu");
-  CHECK_FALSE(colour.isValid());
+  Colour colour;
+  CHECK_FALSE(Colour::parse("#1122334", &colour));
 }
 
-TEST(ColourTestGroup, isValidReturnsFalseForInvalidLength)
+TEST(ColourTestGroup, parseReturnsTrueForValidColourString)
 {
-  Colour colour = Colour("#1122334");
-  CHECK_FALSE(colour.isValid());
+  Colour colour;
+  CHECK(Colour::parse("#112233", &colour));
 }
 
-TEST(ColourTestGroup, isValidReturnsTrueForValidColourString)
+TEST(ColourTestGroup, parseLeavesColourUntouchedWhenInvalid)
 {
-  Colour colour = Colour("#112233");
-  CHECK(colour.isValid());
+  Colour colour = Colour(1, 2, 3);
+  Colour::parse("#11223", &colour);
+  CHECK_EQUAL(Colour(1, 2, 3), colour);
 }
 
 TEST(ColourTestGroup, returnsCorrectRedValueFromString)
 {
-  Colour c = Colour("#11FFA5");
+  Colour c = parsed("#11FFA5");
   BYTES_EQUAL((uint8_t)17, c.getRed());
 }
 
 TEST(ColourTestGroup, returnsCorrectGreenValueFromString)
 {
-  Colour c = Colour("#00FEA5");
+  Colour c = parsed("#00FEA5");
   BYTES_EQUAL((uint8_t)254, c.getGreen());
 }
 
 TEST(ColourTestGroup, returnsCorrectBlueValueFromString)
 {
-  Colour c = Colour("#00FFA5");
+  Colour c = parsed("#00FFA5");
   BYTES_EQUAL((uint8_t)165, c.getBlue());
 }
 
 TEST(ColourTestGroup, comparesValuesForEquality)
 {
-  Colour c1 = Colour("#00FFA5");
-  Colour c2 = Colour("#00FFA5");
+  Colour c1 = parsed("#00FFA5");
+  Colour c2 = parsed("#00FFA5");
 
   CHECK_EQUAL(c1, c2);
 }
 
+TEST(ColourTestGroup, packsChannelsAsWhiteRedGreenBlue)
+{
+  static_assert(Colour(0x11, 0x22, 0x33, 0x44).packed() == 0x44112233, "channels packed out of order");
+
+  Colour c = Colour::fromPacked(0x44112233);
+  BYTES_EQUAL(0x11, c.getRed());
+  BYTES_EQUAL(0x22, c.getGreen());
+  BYTES_EQUAL(0x33, c.getBlue());
+  BYTES_EQUAL(0x44, c.getWhite());
+}
+
+TEST(ColourTestGroup, whiteChannelTakesPartInEquality)
+{
+  CHECK(Colour(1, 2, 3, 4) != Colour(1, 2, 3));
+}
+
+//straightforward '#rrggbb' parser to check Colour::parse against
+static bool referenceParse(const char *value, uint32_t *rgb) {
+  if (strlen(value) != 7 || value[0] != '#') {
+    return false;
+  }
+
+  for (int i=1; i<7; i++) {
+    if (!isxdigit((unsigned char)value[i])) {
+      return false;
+    }
+  }
+
+  *rgb = strtoul(&value[1], nullptr, 16);
+  return true;
+}
+
+TEST(ColourTestGroup, parseMatchesReferenceForRandomStrings)
+{
+  const char ALPHABET[] = "#0123456789abcdefABCDEFgG x";
+  uint32_t seed = 12345;
+  char value[12];
+
+  for (int n=0; n<50000; n++) {
+    seed = seed * 1103515245 + 12345;
+    const uint32_t len = (seed >> 16) % 10;
+
+    for (uint32_t i=0; i<len; i++) {
+      seed = seed * 1103515245 + 12345;
+      const uint32_t r = seed >> 16;
+
+      //mostly plausible characters, some arbitrary bytes
+      value[i] = (r & 0xF) ? ALPHABET[(r >> 4) % (sizeof(ALPHABET) - 1)] : (char)(1 + (r >> 4) % 255);
+    }
+    //most strings start with '#' so the digits get exercised
+    if (len > 0 && (seed & 0x30000000)) {
+      value[0] = '#';
+    }
+    value[len] = '\0';
+
+    uint32_t expected = 0;
+    const bool expectedValid = referenceParse(value, &expected);
+    Colour colour = Colour(1, 2, 3);
+    const bool valid = Colour::parse(value, &colour);
+
+    CHECK_EQUAL_TEXT(expectedValid, valid, value);
+    if (expectedValid) {
+      LONGS_EQUAL_TEXT(expected, colour.packed(), value);
+    } else {
+      CHECK_EQUAL_TEXT(Colour(1, 2, 3), colour, value);
+    }
+  }
+}
+
+TEST(ColourTestGroup, parseMatchesReferenceForEveryByteInEveryDigit)
+{
+  char value[] = "#000000";
+
+  for (int pos=1; pos<7; pos++) {
+    for (int c=1; c<256; c++) {
+      value[pos] = (char)c;
+
+      uint32_t expected = 0;
+      Colour colour;
+      const bool expectedValid = referenceParse(value, &expected);
+
+      CHECK_EQUAL(expectedValid, Colour::parse(value, &colour));
+      if (expectedValid) {
+        LONGS_EQUAL(expected, colour.packed());
+      }
+    }
+    value[pos] = '0';
+  }
+}
+
 TEST(ColourTestGroup, toStringReturnsCorrectResult)
 {
   uint8_t red = 0xA5;
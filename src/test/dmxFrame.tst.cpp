@@ -0,0 +1,69 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "dmxFrame.h"
+
+static dmx_frame_config_t config = {
+  .startSlot = 0,
+  .minSlots = 24,
+  .breakToBreakMinUs = 1204,
+};
+
+TEST_GROUP(DmxFrameTestGroup)
+{
+  void setup() {
+    config.startSlot = 0;
+    config.minSlots = 24;
+  }
+};
+
+TEST(DmxFrameTestGroup, sendsUpToLastPatchedSlot)
+{
+  LONGS_EQUAL(54, dmxFrame::length(&config, 54));
+}
+
+TEST(DmxFrameTestGroup, countsFromStartSlot)
+{
+  config.startSlot = 100;
+
+  LONGS_EQUAL(154, dmxFrame::length(&config, 54));
+}
+
+TEST(DmxFrameTestGroup, padsToMinimum)
+{
+  LONGS_EQUAL(24, dmxFrame::length(&config, 6));
+}
+
+TEST(DmxFrameTestGroup, noMinimum)
+{
+  config.minSlots = 0;
+
+  LONGS_EQUAL(6, dmxFrame::length(&config, 6));
+}
+
+TEST(DmxFrameTestGroup, minimumCoversStartSlot)
+{
+  config.startSlot = 20;
+
+  LONGS_EQUAL(26, dmxFrame::length(&config, 6));
+}
+
+TEST(DmxFrameTestGroup, limitedToUniverse)
+{
+  config.startSlot = 500;
+  config.minSlots = 600;
+
+  LONGS_EQUAL(DMX_UNIVERSE_SLOTS, dmxFrame::length(&config, 54));
+}
+
+//6 slots take 137us for the break and mark after break and 44us for the start code and each slot
+TEST(DmxFrameTestGroup, shortFramesHoldMarkBeforeBreak)
+{
+  LONGS_EQUAL(1204 - 445, dmxFrame::markBeforeBreakUs(&config, 445));
+}
+
+TEST(DmxFrameTestGroup, longFramesDontWait)
+{
+  LONGS_EQUAL(0, dmxFrame::markBeforeBreakUs(&config, 1204));
+  LONGS_EQUAL(0, dmxFrame::markBeforeBreakUs(&config, 25000));
+}
@@ -0,0 +1,193 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "dmxMerge.h"
+#include <stdlib.h>
+
+#define LENGTH (NUM_LEDS * COLOURS_PER_LED)
+
+static uint8_t pattern[LENGTH];
+static uint8_t input[LENGTH];
+static uint8_t output[LENGTH + 4];
+
+static DmxMerge* mergeAll(MergeMode mode) {
+  static const merge_range_t ranges[][1] = {
+    {{ .first = 0, .count = LENGTH, .mode = mergePattern }},
+    {{ .first = 0, .count = LENGTH, .mode = mergeInput }},
+    {{ .first = 0, .count = LENGTH, .mode = mergeHtp }},
+    {{ .first = 0, .count = LENGTH, .mode = mergeLtp }},
+  };
+
+  return new DmxMerge(ranges[mode], 1);
+}
+
+TEST_GROUP(DmxMergeTestGroup)
+{
+  void setup() {
+    memset(pattern, 0, sizeof(pattern));
+    memset(input, 0, sizeof(input));
+    memset(output, 0xAA, sizeof(output));
+  }
+};
+
+TEST(DmxMergeTestGroup, patternOnly)
+{
+  DmxMerge *merge = mergeAll(mergePattern);
+  pattern[0] = 10;
+  input[0] = 200;
+
+  merge->merge(output, pattern, input, LENGTH);
+
+  BYTES_EQUAL(10, output[0]);
+  delete merge;
+}
+
+TEST(DmxMergeTestGroup, inputOnly)
+{
+  DmxMerge *merge = mergeAll(mergeInput);
+  pattern[0] = 200;
+  input[0] = 10;
+
+  merge->merge(output, pattern, input, LENGTH);
+
+  BYTES_EQUAL(10, output[0]);
+  delete merge;
+}
+
+TEST(DmxMergeTestGroup, highestTakesPrecedence)
+{
+  DmxMerge *merge = mergeAll(mergeHtp);
+  const uint8_t patternValues[] = {0, 255, 127, 128, 200, 1, 255, 0};
+  const uint8_t inputValues[] = {0, 0, 128, 127, 201, 0, 255, 255};
+  const uint8_t expected[] = {0, 255, 128, 128, 201, 1, 255, 255};
+
+  memcpy(pattern, patternValues, sizeof(patternValues));
+  memcpy(input, inputValues, sizeof(inputValues));
+
+  merge->merge(output, pattern, input, LENGTH);
+
+  for (uint32_t i=0; i<sizeof(expected); i++) {
+    BYTES_EQUAL(expected[i], output[i]);
+  }
+
+  delete merge;
+}
+
+TEST(DmxMergeTestGroup, highestTakesPrecedenceMatchesMax)
+{
+  DmxMerge *merge = mergeAll(mergeHtp);
+  srand(45);
+
+  for (uint32_t round=0; round<1000; round++) {
+    for (uint32_t i=0; i<LENGTH; i++) {
+      pattern[i] = rand();
+      input[i] = rand();
+    }
+
+    merge->merge(output, pattern, input, LENGTH);
+
+    for (uint32_t i=0; i<LENGTH; i++) {
+      BYTES_EQUAL(pattern[i] > input[i] ? pattern[i] : input[i], output[i]);
+    }
+  }
+
+  delete merge;
+}
+
+TEST(DmxMergeTestGroup, latestTakesPrecedence)
+{
+  DmxMerge *merge = mergeAll(mergeLtp);
+
+  pattern[0] = 100;
+  merge->merge(output, pattern, input, LENGTH);
+  BYTES_EQUAL(100, output[0]);
+
+  //the console moves a fader below the pattern's value
+  input[0] = 20;
+  merge->merge(output, pattern, input, LENGTH);
+  BYTES_EQUAL(20, output[0]);
+
+  //held while neither changes
+  merge->merge(output, pattern, input, LENGTH);
+  BYTES_EQUAL(20, output[0]);
+
+  pattern[0] = 50;
+  merge->merge(output, pattern, input, LENGTH);
+  BYTES_EQUAL(50, output[0]);
+
+  delete merge;
+}
+
+TEST(DmxMergeTestGroup, latestTakesPrecedenceBySlot)
+{
+  DmxMerge *merge = mergeAll(mergeLtp);
+
+  pattern[0] = 100;
+  pattern[5] = 100;
+  merge->merge(output, pattern, input, LENGTH);
+
+  input[5] = 30;
+  merge->merge(output, pattern, input, LENGTH);
+
+  BYTES_EQUAL(100, output[0]);
+  BYTES_EQUAL(30, output[5]);
+  delete merge;
+}
+
+TEST(DmxMergeTestGroup, consoleWinsTie)
+{
+  DmxMerge *merge = mergeAll(mergeLtp);
+
+  pattern[0] = 100;
+  input[0] = 30;
+  merge->merge(output, pattern, input, LENGTH);
+
+  BYTES_EQUAL(30, output[0]);
+  delete merge;
+}
+
+TEST(DmxMergeTestGroup, modesByRange)
+{
+  const merge_range_t ranges[] = {
+    { .first = 1, .count = 2, .mode = mergeInput },
+    { .first = 3, .count = 3, .mode = mergeHtp },
+  };
+  DmxMerge merge(ranges, 2);
+
+  memset(pattern, 100, sizeof(pattern));
+  memset(input, 50, sizeof(input));
+  input[4] = 150;
+
+  merge.merge(output, pattern, input, LENGTH);
+
+  const uint8_t expected[] = {100, 50, 50, 100, 150, 100, 100};
+  for (uint32_t i=0; i<sizeof(expected); i++) {
+    BYTES_EQUAL(expected[i], output[i]);
+  }
+}
+
+TEST(DmxMergeTestGroup, writesOnlyLength)
+{
+  DmxMerge *merge = mergeAll(mergeInput);
+  memset(input, 7, sizeof(input));
+
+  merge->merge(output, pattern, input, 5);
+
+  BYTES_EQUAL(7, output[4]);
+  BYTES_EQUAL(0xAA, output[5]);
+  delete merge;
+}
+
+TEST(DmxMergeTestGroup, mergesInPlace)
+{
+  DmxMerge *merge = mergeAll(mergeHtp);
+  pattern[LENGTH - 1] = 9;
+  input[LENGTH - 1] = 3;
+  input[0] = 4;
+
+  merge->merge(input, pattern, input, LENGTH);
+
+  BYTES_EQUAL(4, input[0]);
+  BYTES_EQUAL(9, input[LENGTH - 1]);
+  delete merge;
+}
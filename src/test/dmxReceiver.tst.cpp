@@ -0,0 +1,176 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "dmxReceiver.h"
+
+#define TIMEOUT_MS 1000
+
+static DmxReceiver *receiver;
+static uint8_t output[8];
+
+//capture a frame as DMA would, the start code, the slots then the next break's 0
+static void receive(uint8_t startCode, const uint8_t *slots, uint32_t length, uint32_t nowMs) {
+  uint8_t *buffer = receiver->captureBuffer();
+
+  buffer[0] = startCode;
+  memcpy(&buffer[1], slots, length);
+  buffer[1 + length] = 0;
+
+  receiver->onBreak(length + 2, false, nowMs);
+}
+
+static const uint8_t FRAME_A[] = {10, 20, 30, 40};
+static const uint8_t FRAME_B[] = {50, 60, 70, 80};
+
+TEST_GROUP(DmxReceiverTestGroup)
+{
+  void setup() {
+    receiver = new DmxReceiver(TIMEOUT_MS);
+    memset(output, 0xAA, sizeof(output));
+
+    //lines up with the frames
+    receiver->onBreak(100, false, 0);
+  }
+
+  void teardown() {
+    delete receiver;
+  }
+};
+
+TEST(DmxReceiverTestGroup, dropsFirstPartialFrame)
+{
+  LONGS_EQUAL(0, receiver->stats()->frames);
+  LONGS_EQUAL(0, receiver->read(output, 0, 4));
+  BYTES_EQUAL(0, output[0]);
+  CHECK_FALSE(receiver->isLive(0));
+}
+
+TEST(DmxReceiverTestGroup, readsCompleteFrame)
+{
+  receive(0, FRAME_A, 4, 23);
+
+  LONGS_EQUAL(4, receiver->read(output, 0, 4));
+  for (uint32_t i=0; i<4; i++) {
+    BYTES_EQUAL(FRAME_A[i], output[i]);
+  }
+
+  LONGS_EQUAL(1, receiver->stats()->frames);
+  LONGS_EQUAL(4, receiver->stats()->slots);
+}
+
+TEST(DmxReceiverTestGroup, readsFromFirstSlot)
+{
+  receive(0, FRAME_A, 4, 23);
+
+  LONGS_EQUAL(2, receiver->read(output, 2, 2));
+  BYTES_EQUAL(30, output[0]);
+  BYTES_EQUAL(40, output[1]);
+}
+
+TEST(DmxReceiverTestGroup, slotsPastEndOfFrameReadAsZero)
+{
+  receive(0, FRAME_A, 4, 23);
+
+  LONGS_EQUAL(1, receiver->read(output, 3, 3));
+  BYTES_EQUAL(40, output[0]);
+  BYTES_EQUAL(0, output[1]);
+  BYTES_EQUAL(0, output[2]);
+  BYTES_EQUAL(0xAA, output[3]);
+}
+
+TEST(DmxReceiverTestGroup, swapsBuffersOnEachFrame)
+{
+  uint8_t *first = receiver->captureBuffer();
+  receive(0, FRAME_A, 4, 23);
+  uint8_t *second = receiver->captureBuffer();
+  receive(0, FRAME_B, 4, 46);
+
+  CHECK(first != second);
+  POINTERS_EQUAL(first, receiver->captureBuffer());
+
+  receiver->read(output, 0, 4);
+  BYTES_EQUAL(50, output[0]);
+}
+
+TEST(DmxReceiverTestGroup, capturingDoesNotChangeLastFrame)
+{
+  receive(0, FRAME_A, 4, 23);
+  memset(receiver->captureBuffer(), 0xFF, DMX_RECEIVE_BUFFER_SIZE);
+
+  receiver->read(output, 0, 4);
+  BYTES_EQUAL(10, output[0]);
+}
+
+TEST(DmxReceiverTestGroup, dropsShortFrames)
+{
+  receive(0, FRAME_A, 4, 23);
+  uint8_t *buffer = receiver->captureBuffer();
+
+  POINTERS_EQUAL(buffer, receiver->onBreak(1, false, 30));
+  POINTERS_EQUAL(buffer, receiver->onBreak(2, false, 31));
+
+  LONGS_EQUAL(2, receiver->stats()->shortFrames);
+  LONGS_EQUAL(1, receiver->stats()->frames);
+}
+
+TEST(DmxReceiverTestGroup, dropsLongFrames)
+{
+  uint8_t *buffer = receiver->captureBuffer();
+
+  POINTERS_EQUAL(buffer, receiver->onBreak(DMX_RECEIVE_BUFFER_SIZE, true, 23));
+
+  LONGS_EQUAL(1, receiver->stats()->longFrames);
+  LONGS_EQUAL(0, receiver->stats()->frames);
+}
+
+TEST(DmxReceiverTestGroup, readsFullUniverse)
+{
+  uint8_t slots[DMX_UNIVERSE_SLOTS];
+  for (uint32_t i=0; i<DMX_UNIVERSE_SLOTS; i++) {
+    slots[i] = i;
+  }
+
+  receive(0, slots, DMX_UNIVERSE_SLOTS, 23);
+
+  LONGS_EQUAL(DMX_UNIVERSE_SLOTS, receiver->stats()->slots);
+  LONGS_EQUAL(1, receiver->read(output, DMX_UNIVERSE_SLOTS - 1, 4));
+  BYTES_EQUAL(255, output[0]);
+}
+
+TEST(DmxReceiverTestGroup, dropsAlternateStartCodes)
+{
+  receive(0xCC, FRAME_A, 4, 23);
+
+  LONGS_EQUAL(1, receiver->stats()->otherStartCodes);
+  LONGS_EQUAL(0, receiver->stats()->frames);
+}
+
+TEST(DmxReceiverTestGroup, averagesFrameInterval)
+{
+  uint32_t nowMs = 0;
+
+  for (uint32_t i=0; i<50; i++) {
+    nowMs += i % 2 == 0 ? 22 : 23;
+    receive(0, FRAME_A, 4, nowMs);
+  }
+
+  CHECK(receiver->stats()->intervalUs >= 22000);
+  CHECK(receiver->stats()->intervalUs <= 23000);
+}
+
+TEST(DmxReceiverTestGroup, signalReturningIsNotAnInterval)
+{
+  receive(0, FRAME_A, 4, 23);
+  receive(0, FRAME_A, 4, 46);
+  receive(0, FRAME_A, 4, 46 + TIMEOUT_MS * 5);
+
+  LONGS_EQUAL(23000, receiver->stats()->intervalUs);
+}
+
+TEST(DmxReceiverTestGroup, timesOut)
+{
+  receive(0, FRAME_A, 4, 100);
+
+  CHECK_TRUE(receiver->isLive(100 + TIMEOUT_MS - 1));
+  CHECK_FALSE(receiver->isLive(100 + TIMEOUT_MS));
+}
@@ -0,0 +1,136 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "dmxStats.h"
+
+#define BREAK_STOP_US 25
+
+static DmxTxStats *stats;
+
+//a frame of 54 slots every 25ms, 112us break, a 10us gap switching the baud rate and 44us a slot
+static void sendFrame(uint32_t startUs) {
+  const uint32_t breakEndUs = startUs + 112 + BREAK_STOP_US;
+  const uint32_t slotsStartUs = breakEndUs + 10;
+
+  stats->frameSent(startUs, startUs, breakEndUs, slotsStartUs, slotsStartUs + 55 * 44, 55);
+}
+
+TEST_GROUP(DmxStatsTestGroup)
+{
+  void setup() {
+    stats = new DmxTxStats(BREAK_STOP_US);
+  }
+
+  void teardown() {
+    delete stats;
+  }
+};
+
+TEST(DmxStatsTestGroup, countsFramesAndBytes)
+{
+  sendFrame(1000);
+  sendFrame(26000);
+
+  LONGS_EQUAL(2, stats->stats()->frames);
+  LONGS_EQUAL(110, stats->stats()->bytes);
+}
+
+TEST(DmxStatsTestGroup, splitsWireTime)
+{
+  sendFrame(1000);
+
+  LONGS_EQUAL(112, stats->stats()->breakUs);
+  LONGS_EQUAL(BREAK_STOP_US + 10, stats->stats()->mabUs);
+  LONGS_EQUAL(55 * 44, stats->stats()->slotsUs);
+  LONGS_EQUAL(112 + BREAK_STOP_US + 10 + 55 * 44, stats->stats()->blockedUs);
+}
+
+TEST(DmxStatsTestGroup, countsHoldAsBlocked)
+{
+  //a short frame held 900us at mark before its break
+  stats->frameSent(100, 1000, 1000 + 112 + BREAK_STOP_US, 1000 + 112 + BREAK_STOP_US + 10, 1300, 2);
+
+  LONGS_EQUAL(900, stats->stats()->holdUs);
+  LONGS_EQUAL(112, stats->stats()->breakUs);
+  LONGS_EQUAL(1200, stats->stats()->blockedUs);
+}
+
+TEST(DmxStatsTestGroup, intervalFromBreakToBreak)
+{
+  stats->frameSent(0, 500, 600, 610, 700, 2);
+  stats->frameSent(700, 1500, 1600, 1610, 1700, 2);
+
+  LONGS_EQUAL(1000, stats->stats()->intervalUs);
+}
+
+TEST(DmxStatsTestGroup, breakShorterThanStopBits)
+{
+  stats->frameSent(1000, 1000, 1010, 1020, 1100, 2);
+
+  LONGS_EQUAL(0, stats->stats()->breakUs);
+  LONGS_EQUAL(20, stats->stats()->mabUs);
+}
+
+TEST(DmxStatsTestGroup, totalsBlockedTime)
+{
+  for (uint32_t i=0; i<100; i++) {
+    sendFrame(i * 25000);
+  }
+
+  //2567us a frame
+  LONGS_EQUAL(256, stats->stats()->blockedMs);
+}
+
+TEST(DmxStatsTestGroup, averagesRefreshRate)
+{
+  for (uint32_t i=0; i<50; i++) {
+    sendFrame(i * 25000);
+  }
+
+  LONGS_EQUAL(25000, stats->stats()->intervalUs);
+  LONGS_EQUAL(400, stats->refreshRate10());
+}
+
+TEST(DmxStatsTestGroup, refreshRateFollowsSlowerFrames)
+{
+  for (uint32_t i=0; i<50; i++) {
+    sendFrame(i * 25000);
+  }
+
+  for (uint32_t i=1; i<=50; i++) {
+    sendFrame(49 * 25000 + i * 50000);
+  }
+
+  CHECK(stats->refreshRate10() >= 200);
+  CHECK(stats->refreshRate10() < 205);
+}
+
+TEST(DmxStatsTestGroup, noRateUntilTwoFrames)
+{
+  LONGS_EQUAL(0, stats->refreshRate10());
+  sendFrame(1000);
+  LONGS_EQUAL(0, stats->refreshRate10());
+}
+
+TEST(DmxStatsTestGroup, summary)
+{
+  char output[DMX_STATS_SUMMARY_SIZE];
+
+  sendFrame(0);
+  sendFrame(25000);
+
+  const uint32_t length = stats->summary(output, sizeof(output));
+
+  STRCMP_EQUAL("2,110,0,112,35,2420,2567,5,40.0", output);
+  LONGS_EQUAL(strlen(output), length);
+}
+
+TEST(DmxStatsTestGroup, summaryTruncates)
+{
+  char output[8];
+
+  sendFrame(0);
+
+  LONGS_EQUAL(7, stats->summary(output, sizeof(output)));
+  STRCMP_EQUAL("1,55,0,", output);
+}
@@ -0,0 +1,105 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "fixture.h"
+#include "config.h"
+
+static const uint16_t IDENTITY_MAP[] = {0, 1};
+
+//two LEDs, RGB
+static const uint8_t VALUES[] = {
+  200, 100, 50,
+  10, 20, 30,
+};
+
+static uint8_t output[2 * FIXTURE_SLOTS_MAX];
+
+static void verify_output(const uint8_t *expected, uint32_t len) {
+  for (uint32_t i=0; i<len; i++) {
+    BYTES_EQUAL(expected[i], output[i]);
+  }
+}
+
+TEST_GROUP(FixtureTestGroup)
+{
+  void setup() {
+    memset(output, 0xAA, sizeof(output));
+  }
+};
+
+TEST(FixtureTestGroup, packsRgb)
+{
+  const uint8_t expected[] = {200, 100, 50, 10, 20, 30};
+
+  fixture::pack(output, VALUES, IDENTITY_MAP, 2, &fixture::PROFILE_RGB);
+
+  LONGS_EQUAL(3, fixture::PROFILE_RGB.slots);
+  verify_output(expected, sizeof(expected));
+}
+
+TEST(FixtureTestGroup, packsGrb)
+{
+  const uint8_t expected[] = {100, 200, 50, 20, 10, 30};
+
+  fixture::pack(output, VALUES, IDENTITY_MAP, 2, &fixture::PROFILE_GRB);
+
+  verify_output(expected, sizeof(expected));
+}
+
+TEST(FixtureTestGroup, extractsWhiteForRgbw)
+{
+  const uint8_t expected[] = {150, 50, 0, 50, 0, 10, 20, 10};
+
+  fixture::pack(output, VALUES, IDENTITY_MAP, 2, &fixture::PROFILE_RGBW);
+
+  LONGS_EQUAL(4, fixture::PROFILE_RGBW.slots);
+  verify_output(expected, sizeof(expected));
+}
+
+TEST(FixtureTestGroup, holdsAmberAtDefaultForRgba)
+{
+  const uint8_t expected[] = {200, 100, 50, 0, 10, 20, 30, 0};
+
+  fixture::pack(output, VALUES, IDENTITY_MAP, 2, &fixture::PROFILE_RGBA);
+
+  verify_output(expected, sizeof(expected));
+}
+
+TEST(FixtureTestGroup, holdsDimmerAtFullForDimmerRgb)
+{
+  const uint8_t expected[] = {255, 200, 100, 50, 255, 10, 20, 30};
+
+  fixture::pack(output, VALUES, IDENTITY_MAP, 2, &fixture::PROFILE_DIMMER_RGB);
+
+  verify_output(expected, sizeof(expected));
+}
+
+TEST(FixtureTestGroup, expandsToCoarseAndFineFor16Bit)
+{
+  const uint8_t expected[] = {200, 200, 100, 100, 50, 50, 10, 10, 20, 20, 30, 30};
+
+  fixture::pack(output, VALUES, IDENTITY_MAP, 2, &fixture::PROFILE_RGB16);
+
+  LONGS_EQUAL(6, fixture::PROFILE_RGB16.slots);
+  verify_output(expected, sizeof(expected));
+}
+
+TEST(FixtureTestGroup, gathersLedsThroughMap)
+{
+  const uint16_t map[] = {1, 1, 0};
+  const uint8_t expected[] = {10, 20, 30, 10, 20, 30, 200, 100, 50};
+  uint8_t out[3 * 3];
+
+  fixture::pack(out, VALUES, map, 3, &fixture::PROFILE_RGB);
+
+  for (uint32_t i=0; i<sizeof(expected); i++) {
+    BYTES_EQUAL(expected[i], out[i]);
+  }
+}
+
+TEST(FixtureTestGroup, writesNoMoreThanItsSlots)
+{
+  fixture::pack(output, VALUES, IDENTITY_MAP, 2, &fixture::PROFILE_RGBW);
+
+  BYTES_EQUAL(0xAA, output[2 * fixture::PROFILE_RGBW.slots]);
+}
@@ -0,0 +1,149 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "framePacer.h"
+
+#define RESOLUTION_MS 25
+
+static frame_pacer_config_t config = {
+  .resolutionMs = RESOLUTION_MS,
+  .policy = overrunSkip,
+  .intervalMaxMs = 100,
+  .recoverFrames = 4,
+};
+
+static FramePacer *pacer;
+
+TEST_GROUP(FramePacerTestGroup)
+{
+  void setup() {
+    config.policy = overrunSkip;
+    pacer = new FramePacer(&config);
+    pacer->start(1000);
+  }
+
+  void teardown() {
+    delete pacer;
+  }
+};
+
+TEST(FramePacerTestGroup, oneFrameOnTime)
+{
+  LONGS_EQUAL(1, pacer->tick(1025));
+  LONGS_EQUAL(0, pacer->stats()->missedFrames);
+}
+
+TEST(FramePacerTestGroup, toleratesJitter)
+{
+  LONGS_EQUAL(1, pacer->tick(1037));
+  LONGS_EQUAL(1, pacer->tick(1050));
+  LONGS_EQUAL(0, pacer->stats()->missedFrames);
+}
+
+TEST(FramePacerTestGroup, countsMissedFrames)
+{
+  LONGS_EQUAL(3, pacer->tick(1080));
+  LONGS_EQUAL(2, pacer->stats()->missedFrames);
+}
+
+TEST(FramePacerTestGroup, missedFramesAreInThePast)
+{
+  pacer->tick(1080);
+
+  LONGS_EQUAL(1030, pacer->frameTime(0));
+  LONGS_EQUAL(1055, pacer->frameTime(1));
+  LONGS_EQUAL(1080, pacer->frameTime(2));
+}
+
+TEST(FramePacerTestGroup, countsOverruns)
+{
+  pacer->tick(1025);
+  pacer->frameDone(1025, 1060);
+
+  LONGS_EQUAL(1, pacer->stats()->frames);
+  LONGS_EQUAL(1, pacer->stats()->overruns);
+  LONGS_EQUAL(RESOLUTION_MS, pacer->stats()->intervalMs);
+}
+
+TEST(FramePacerTestGroup, adaptiveSlowsDownOnOverrun)
+{
+  config.policy = overrunAdapt;
+
+  pacer->tick(1025);
+  pacer->frameDone(1025, 1060);
+
+  LONGS_EQUAL(50, pacer->stats()->intervalMs);
+  LONGS_EQUAL(0, pacer->tick(1060));
+  LONGS_EQUAL(1, pacer->tick(1075));
+}
+
+TEST(FramePacerTestGroup, adaptiveSlowsDownOnMissedFrames)
+{
+  config.policy = overrunAdapt;
+
+  pacer->tick(1075);
+
+  LONGS_EQUAL(50, pacer->stats()->intervalMs);
+}
+
+TEST(FramePacerTestGroup, adaptiveBacksOffNoFurtherThanMax)
+{
+  config.policy = overrunAdapt;
+
+  for (uint32_t i=0; i<10; i++) {
+    pacer->frameDone(0, 500);
+  }
+
+  LONGS_EQUAL(100, pacer->stats()->intervalMs);
+}
+
+TEST(FramePacerTestGroup, adaptiveRecoversAfterGoodFrames)
+{
+  config.policy = overrunAdapt;
+
+  pacer->frameDone(0, 40);
+  for (uint32_t i=0; i<3; i++) {
+    pacer->frameDone(0, 5);
+  }
+  LONGS_EQUAL(50, pacer->stats()->intervalMs);
+
+  pacer->frameDone(0, 5);
+  LONGS_EQUAL(RESOLUTION_MS, pacer->stats()->intervalMs);
+}
+
+TEST(FramePacerTestGroup, skipPolicyKeepsRate)
+{
+  pacer->tick(1100);
+  pacer->frameDone(1100, 1200);
+
+  LONGS_EQUAL(RESOLUTION_MS, pacer->stats()->intervalMs);
+}
+
+TEST(FramePacerTestGroup, holdsUntilChange)
+{
+  pacer->tick(1025);
+  pacer->holdFor(100);
+
+  LONGS_EQUAL(0, pacer->tick(1050));
+  LONGS_EQUAL(0, pacer->tick(1100));
+  LONGS_EQUAL(1, pacer->tick(1125));
+  LONGS_EQUAL(0, pacer->stats()->missedFrames);
+}
+
+TEST(FramePacerTestGroup, shortHoldKeepsFrameRate)
+{
+  pacer->tick(1025);
+  pacer->holdFor(5);
+
+  LONGS_EQUAL(1, pacer->tick(1050));
+}
+
+TEST(FramePacerTestGroup, wakeCutsHoldShort)
+{
+  pacer->tick(1025);
+  pacer->holdFor(1000);
+  pacer->wake(1060);
+
+  LONGS_EQUAL(1, pacer->tick(1075));
+  LONGS_EQUAL(0, pacer->stats()->missedFrames);
+}
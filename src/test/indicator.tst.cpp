@@ -0,0 +1,63 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "indicator.h"
+
+static indicator_t testIndicator;
+
+TEST_GROUP(IndicatorTestGroup)
+{
+  void setup() {
+    indicator::set(&testIndicator, 400, 100);
+  }
+
+  void teardown() {
+  }
+};
+
+TEST(IndicatorTestGroup, onAtStartOfPeriod)
+{
+  CHECK(indicator::tick(&testIndicator, 100));
+}
+
+TEST(IndicatorTestGroup, offAfterOnTime)
+{
+  indicator::tick(&testIndicator, 100);
+
+  CHECK(!indicator::tick(&testIndicator, 100));
+  CHECK(!indicator::tick(&testIndicator, 100));
+  CHECK(!indicator::tick(&testIndicator, 100));
+}
+
+TEST(IndicatorTestGroup, repeatsEachPeriod)
+{
+  for (uint32_t i=0; i<4; i++) {
+    indicator::tick(&testIndicator, 100);
+  }
+
+  CHECK(indicator::tick(&testIndicator, 100));
+}
+
+TEST(IndicatorTestGroup, setRestartsPeriod)
+{
+  indicator::tick(&testIndicator, 100);
+  indicator::tick(&testIndicator, 100);
+  indicator::set(&testIndicator, 200, 100);
+
+  CHECK(indicator::tick(&testIndicator, 100));
+}
+
+TEST(IndicatorTestGroup, zeroOnTimeIsOff)
+{
+  indicator::set(&testIndicator, 200, 0);
+
+  CHECK(!indicator::tick(&testIndicator, 100));
+}
+
+TEST(IndicatorTestGroup, zeroPeriodHoldsState)
+{
+  indicator::set(&testIndicator, 0, 1);
+
+  CHECK(indicator::tick(&testIndicator, 100));
+  CHECK(indicator::tick(&testIndicator, 100));
+}
@@ -0,0 +1,96 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ledSpiEncoder.h"
+
+#define MAX_BYTES 4
+
+static uint8_t output[MAX_BYTES * 4 + 1];
+static uint8_t expected[MAX_BYTES * 4];
+
+//bit at a time reference, a 0 is a single high SPI bit and a 1 is spiBits - 1 high bits
+static void referenceEncode(uint8_t *out, const uint8_t *values, uint32_t length, uint8_t spiBits) {
+  uint32_t bit = 0;
+
+  memset(out, 0, length * spiBits);
+
+  for (uint32_t i=0; i < length; i++) {
+    for (int32_t b=7; b >= 0; b--) {
+      const uint32_t high = (values[i] >> b) & 1 ? spiBits - 1 : 1;
+
+      for (uint32_t j=0; j < spiBits; j++, bit++) {
+        if (j < high) {
+          out[bit / 8] |= 0x80 >> (bit % 8);
+        }
+      }
+    }
+  }
+}
+
+TEST_GROUP(LedSpiEncoderTestGroup)
+{
+  void setup() {
+    memset(output, 0xAA, sizeof(output));
+  }
+};
+
+TEST(LedSpiEncoderTestGroup, encodesZeroAndOneBitsWithThreeSpiBits)
+{
+  //0x80 = 110 then seven 100s
+  const uint8_t value = 0x80;
+  const uint8_t bytes[] = {0xD2, 0x49, 0x24};
+
+  LONGS_EQUAL(3, ledSpiEncoder::encode3(output, &value, 1));
+  MEMCMP_EQUAL(bytes, output, sizeof(bytes));
+}
+
+TEST(LedSpiEncoderTestGroup, encodesZeroAndOneBitsWithFourSpiBits)
+{
+  const uint8_t value = 0x81;
+  const uint8_t bytes[] = {0xE8, 0x88, 0x88, 0x8E};
+
+  LONGS_EQUAL(4, ledSpiEncoder::encode4(output, &value, 1));
+  MEMCMP_EQUAL(bytes, output, sizeof(bytes));
+}
+
+TEST(LedSpiEncoderTestGroup, matchesReferenceForEveryByteWithThreeSpiBits)
+{
+  for (uint32_t v=0; v < 256; v++) {
+    const uint8_t value = (uint8_t)v;
+
+    referenceEncode(expected, &value, 1, 3);
+    ledSpiEncoder::encode3(output, &value, 1);
+
+    MEMCMP_EQUAL(expected, output, 3);
+  }
+}
+
+TEST(LedSpiEncoderTestGroup, matchesReferenceForEveryByteWithFourSpiBits)
+{
+  for (uint32_t v=0; v < 256; v++) {
+    const uint8_t value = (uint8_t)v;
+
+    referenceEncode(expected, &value, 1, 4);
+    ledSpiEncoder::encode4(output, &value, 1);
+
+    MEMCMP_EQUAL(expected, output, 4);
+  }
+}
+
+TEST(LedSpiEncoderTestGroup, encodesBytesInOrderWithoutOverrun)
+{
+  const uint8_t values[MAX_BYTES] = {0x12, 0xFF, 0x00, 0xA5};
+
+  referenceEncode(expected, values, MAX_BYTES, 4);
+
+  LONGS_EQUAL(MAX_BYTES * 4, ledSpiEncoder::encode(output, values, MAX_BYTES, 4));
+  MEMCMP_EQUAL(expected, output, MAX_BYTES * 4);
+  BYTES_EQUAL(0xAA, output[MAX_BYTES * 4]);
+
+  memset(output, 0xAA, sizeof(output));
+  referenceEncode(expected, values, MAX_BYTES, 3);
+
+  LONGS_EQUAL(MAX_BYTES * 3, ledSpiEncoder::encode(output, values, MAX_BYTES, 3));
+  MEMCMP_EQUAL(expected, output, MAX_BYTES * 3);
+  BYTES_EQUAL(0xAA, output[MAX_BYTES * 3]);
+}
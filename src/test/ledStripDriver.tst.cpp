@@ -97,6 +97,35 @@ TEST(LedStripDriverCommonTestGroup, counterIncrementsByResolution)
   LONGS_EQUAL(CONFIG_LEDS_3.resolutionMs, state.counter);
 }
 
+TEST(LedStripDriverCommonTestGroup, renderDoesNotWriteValues)
+{
+  led_strip_state_t state = { .counter = 0 };
+
+  driver->pattern(Pattern::colour)->colourOn((Colour*)&COLOUR_ON);
+  driver->render(&state, values);
+
+  verify_colours((Colour*)&COLOUR_ON, values, 3);
+  BYTES_EQUAL(0, lastValuesWritten[INDEX_RED]);
+  LONGS_EQUAL(CONFIG_LEDS_3.resolutionMs, state.counter);
+}
+
+TEST(LedStripDriverCommonTestGroup, retainedColoursOutliveOriginals)
+{
+  led_strip_state_t state = { .counter = 0 };
+  Colour storage[DRIVER_COLOUR_COUNT];
+  Colour expected = COLOUR_BLUE;
+  Colour *colour = new COLOUR_BLUE;
+
+  driver->pattern(Pattern::colour)->colourOn(colour);
+  driver->retainColours(storage);
+  delete colour;
+
+  driver->onTimerFired(&state, values);
+
+  CHECK(driver->getColourOn() == &storage[0]);
+  verify_colours(&expected, lastValuesWritten, 3);
+}
+
 /***********************************************************************************************
  * Pulse pattern
  **********************************************************************************************/
@@ -130,7 +159,8 @@ TEST(LedStripDriverPulseTestGroup, writesCorrectInitialValues)
 
   led_strip_state_t state = {
     .counter = 0,
-    .dutyDirection = 1,
+    .pattern = Pattern::pulse,
+    .pulse = { .direction = 1 },
   };
 
   driver->onTimerFired(&state, values);
@@ -151,7 +181,8 @@ TEST(LedStripDriverPulseTestGroup, writesCorrectStepValues)
 
   led_strip_state_t state = {
     .counter = 1500,
-    .dutyDirection = 1,
+    .pattern = Pattern::pulse,
+    .pulse = { .direction = 1 },
   };
 
   driver->onTimerFired(&state, values);
@@ -171,7 +202,8 @@ TEST(LedStripDriverPulseTestGroup, writesCorrectFinalValues)
 
   led_strip_state_t state = {
     .counter = 2,
-    .dutyDirection = 1,
+    .pattern = Pattern::pulse,
+    .pulse = { .direction = 1 },
   };
 
   driver->onTimerFired(&state, values);
@@ -191,13 +223,14 @@ TEST(LedStripDriverPulseTestGroup, resetsCounterAndReversesDirection)
 
   led_strip_state_t state = {
     .counter = 3,
-    .dutyDirection = 1,
+    .pattern = Pattern::pulse,
+    .pulse = { .direction = 1 },
   };
 
   driver->onTimerFired(&state, values);
 
   LONGS_EQUAL(1, state.counter);
-  LONGS_EQUAL(-1, state.dutyDirection);
+  LONGS_EQUAL(-1, state.pulse.direction);
 }
 
 TEST(LedStripDriverPulseTestGroup, writesCorrectValuesForReverseDirection)
@@ -212,7 +245,8 @@ TEST(LedStripDriverPulseTestGroup, writesCorrectValuesForReverseDirection)
 
   led_strip_state_t state = {
     .counter = 0,
-    .dutyDirection = -1,
+    .pattern = Pattern::pulse,
+    .pulse = { .direction = -1 },
   };
 
   driver->onTimerFired(&state, values);
@@ -232,7 +266,8 @@ TEST(LedStripDriverPulseTestGroup, writesCorrectValuesWhenDirectionReversed)
 
   led_strip_state_t state = {
     .counter = 3000,
-    .dutyDirection = 1,
+    .pattern = Pattern::pulse,
+    .pulse = { .direction = 1 },
   };
 
   driver->onTimerFired(&state, values);
@@ -450,6 +485,7 @@ TEST(LedStripDriverProgressTestGroup, writesCorrectInitialValue)
 
   led_strip_state_t state = {
     .counter = 0,
+    .pattern = Pattern::progress,
   };
 
   driver->onTimerFired(&state, values);
@@ -467,12 +503,13 @@ TEST(LedStripDriverProgressTestGroup, incrementsProgressValueAfterDelay)
 
   led_strip_state_t state = {
     .counter = DELAY_MS,
-    .progress = 0,
+    .pattern = Pattern::progress,
+    .progress = { .step = 0 },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(1, state.progress);
+  LONGS_EQUAL(1, state.progress.step);
 }
 
 TEST(LedStripDriverProgressTestGroup, resetsCounterAfterDelay)
@@ -484,7 +521,8 @@ TEST(LedStripDriverProgressTestGroup, resetsCounterAfterDelay)
 
   led_strip_state_t state = {
     .counter = DELAY_MS,
-    .progress = 0,
+    .pattern = Pattern::progress,
+    .progress = { .step = 0 },
   };
 
   driver->onTimerFired(&state, values);
@@ -504,7 +542,8 @@ TEST(LedStripDriverProgressTestGroup, writesCorrectValueForForwardDirection)
 
   led_strip_state_t state = {
     .counter = 0,
-    .progress = PROGRESS,
+    .pattern = Pattern::progress,
+    .progress = { .step = PROGRESS },
   };
 
   driver->onTimerFired(&state, values);
@@ -528,12 +567,13 @@ TEST(LedStripDriverProgressTestGroup, resetsProgressAfterFinalValueAndResetDelay
 
   led_strip_state_t state = {
     .counter = DELAY_MS + RESET_DELAY_MS,
-    .progress = FINAL,
+    .pattern = Pattern::progress,
+    .progress = { .step = FINAL },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(0, state.progress);
+  LONGS_EQUAL(0, state.progress.step);
 }
 
 TEST(LedStripDriverProgressTestGroup, doesNotUpdateProgressAfterAllLedsOnButBeforeResetDelay)
@@ -553,12 +593,13 @@ TEST(LedStripDriverProgressTestGroup, doesNotUpdateProgressAfterAllLedsOnButBefo
 
   led_strip_state_t state = {
     .counter = DELAY_MS,
-    .progress = PROGRESS,
+    .pattern = Pattern::progress,
+    .progress = { .step = PROGRESS },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(PROGRESS, state.progress);
+  LONGS_EQUAL(PROGRESS, state.progress.step);
 }
 
 TEST(LedStripDriverProgressTestGroup, writesCorrectValueForReverseDirection)
@@ -573,7 +614,8 @@ TEST(LedStripDriverProgressTestGroup, writesCorrectValueForReverseDirection)
 
   led_strip_state_t state = {
     .counter = 0,
-    .progress = PROGRESS,
+    .pattern = Pattern::progress,
+    .progress = { .step = PROGRESS },
   };
 
   driver->onTimerFired(&state, values);
@@ -597,7 +639,8 @@ TEST(LedStripDriverProgressTestGroup, allLedsOffIfFinalValueLessThanMaxLeds)
 
   led_strip_state_t state = {
     .counter = DELAY_MS + RESET_DELAY_MS,
-    .progress = 0,
+    .pattern = Pattern::progress,
+    .progress = { .step = 0 },
   };
 
   driver->onTimerFired(&state, values);
@@ -620,12 +663,13 @@ TEST(LedStripDriverProgressTestGroup, incrementsByGivenAmount)
 
   led_strip_state_t state = {
     .counter = INCREMENT_DELAY,
-    .progress = 0,
+    .pattern = Pattern::progress,
+    .progress = { .step = 0 },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(INCREMENT, state.progress);
+  LONGS_EQUAL(INCREMENT, state.progress.step);
 }
 
 /***********************************************************************************************
@@ -699,7 +743,8 @@ TEST(LedStripDriverSnakeTestGroup, writesCorrectValuesForInitialState)
 
   led_strip_state_t state = {
     .counter = 0,
-    .progress = 0,
+    .pattern = Pattern::snake,
+    .progress = { .step = 0 },
   };
 
   driver->onTimerFired(&state, values);
@@ -718,12 +763,13 @@ TEST(LedStripDriverSnakeTestGroup, incrementsProgressAtCorrectCounterValue)
 
   led_strip_state_t state = {
     .counter = 200,
-    .progress = 0,
+    .pattern = Pattern::snake,
+    .progress = { .step = 0 },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(1, state.progress);
+  LONGS_EQUAL(1, state.progress.step);
 }
 
 TEST(LedStripDriverSnakeTestGroup, doesNotIncrementProgressForEveryCounterValue)
@@ -737,12 +783,13 @@ TEST(LedStripDriverSnakeTestGroup, doesNotIncrementProgressForEveryCounterValue)
 
   led_strip_state_t state = {
     .counter = 0,
-    .progress = 0,
+    .pattern = Pattern::snake,
+    .progress = { .step = 0 },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(0, state.progress);
+  LONGS_EQUAL(0, state.progress.step);
 }
 
 TEST(LedStripDriverSnakeTestGroup, resetsCounterAtCorrectValue)
@@ -756,7 +803,8 @@ TEST(LedStripDriverSnakeTestGroup, resetsCounterAtCorrectValue)
 
   led_strip_state_t state = {
     .counter = 200,
-    .progress = 0,
+    .pattern = Pattern::snake,
+    .progress = { .step = 0 },
   };
 
   driver->onTimerFired(&state, values);
@@ -775,7 +823,8 @@ TEST(LedStripDriverSnakeTestGroup, writesCorrectValuesForForward)
 
   led_strip_state_t state = {
     .counter = 0,
-    .progress = 2,
+    .pattern = Pattern::snake,
+    .progress = { .step = 2 },
   };
 
   driver->onTimerFired(&state, values);
@@ -795,7 +844,8 @@ TEST(LedStripDriverSnakeTestGroup, writesCorrectValuesForReverse)
 
   led_strip_state_t state = {
     .counter = 0,
-    .progress = 2,
+    .pattern = Pattern::snake,
+    .progress = { .step = 2 },
   };
 
   driver->onTimerFired(&state, values);
@@ -815,7 +865,8 @@ TEST(LedStripDriverSnakeTestGroup, writesCorrectValuesWhenProgressLessThanLength
 
   led_strip_state_t state = {
     .counter = 0,
-    .progress = 2,
+    .pattern = Pattern::snake,
+    .progress = { .step = 2 },
   };
 
   driver->onTimerFired(&state, values);
@@ -835,7 +886,8 @@ TEST(LedStripDriverSnakeTestGroup, writesCorrectValuesWhenProgressMoreThanNumLed
 
   led_strip_state_t state = {
     .counter = 0,
-    .progress = 4,
+    .pattern = Pattern::snake,
+    .progress = { .step = 4 },
   };
 
   driver->onTimerFired(&state, values);
@@ -857,12 +909,13 @@ TEST(LedStripDriverSnakeTestGroup, resetsProgressAfterSnakeNoLongerVisible)
 
   led_strip_state_t state = {
     .counter = 200,
-    .progress = CONFIG_LEDS_3.numLeds + LENGTH,
+    .pattern = Pattern::snake,
+    .progress = { .step = CONFIG_LEDS_3.numLeds + LENGTH },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(0, state.progress);
+  LONGS_EQUAL(0, state.progress.step);
 }
 
 /***********************************************************************************************
@@ -898,7 +951,10 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectInitialValuesForTemperatureLay
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
+    .pattern = Pattern::weather,
+    .weather = {
+      .tempFadeDirection = 1,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -920,7 +976,10 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectMidValuesForTemperatureLayerFo
 
   led_strip_state_t state = {
     .counter = (TEMPERATURE_FADE_INTERVAL_SECS * 1000) / 2,
-    .weatherTempFadeDirection = 1,
+    .pattern = Pattern::weather,
+    .weather = {
+      .tempFadeDirection = 1,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -941,7 +1000,10 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectEndValuesForTemperatureLayerFo
 
   led_strip_state_t state = {
     .counter = (TEMPERATURE_FADE_INTERVAL_SECS * 1000) - WEATHER_TEST_LED_CONFIG.resolutionMs,
-    .weatherTempFadeDirection = 1,
+    .pattern = Pattern::weather,
+    .weather = {
+      .tempFadeDirection = 1,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -962,7 +1024,10 @@ TEST(LedStripDriverWeatherTestGroup, resetsCounter)
 
   led_strip_state_t state = {
     .counter = (TEMPERATURE_FADE_INTERVAL_SECS * 1000),
-    .weatherTempFadeDirection = 1,
+    .pattern = Pattern::weather,
+    .weather = {
+      .tempFadeDirection = 1,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -983,12 +1048,15 @@ TEST(LedStripDriverWeatherTestGroup, changesFadeDirectionWhenCounterReset)
 
   led_strip_state_t state = {
     .counter = (TEMPERATURE_FADE_INTERVAL_SECS * 1000),
-    .weatherTempFadeDirection = -1,
+    .pattern = Pattern::weather,
+    .weather = {
+      .tempFadeDirection = -1,
+    },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(1, state.weatherTempFadeDirection);
+  LONGS_EQUAL(1, state.weather.tempFadeDirection);
 }
 
 TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForEndTemperatureLayerBackwardDirection)
@@ -1004,12 +1072,14 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForEndTemperatureLayerBa
 
   led_strip_state_t state = {
     .counter = (TEMPERATURE_FADE_INTERVAL_SECS * 1000),
-    .weatherTempFadeDirection = -1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
-
-    .weatherWarningCounter = 0,
-    .weatherWarningFadeState = fadeIn,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .warningCounter = 0,
+      .tempFadeDirection = -1,
+      .rainPosition = 0,
+      .warningFadeState = fadeIn,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1035,9 +1105,12 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForInitialRainCounter)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1069,14 +1142,17 @@ TEST(LedStripDriverWeatherTestGroup, incrementsRainCounterCorrectly)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+    },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(WEATHER_TEST_LED_CONFIG.resolutionMs, state.weatherRainCounter);
+  LONGS_EQUAL(WEATHER_TEST_LED_CONFIG.resolutionMs, state.weather.rainCounter);
 }
 
 TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForIncrementedRainPosition)
@@ -1098,9 +1174,12 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForIncrementedRainPositi
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 1,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 1,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1132,14 +1211,17 @@ TEST(LedStripDriverWeatherTestGroup, incrementsRainPositionCorrectly)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = RAIN_INC_DELAY_MS - 1,
-    .weatherRainPosition = 0,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = RAIN_INC_DELAY_MS - 1,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+    },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(1, state.weatherRainPosition);
+  LONGS_EQUAL(1, state.weather.rainPosition);
 }
 
 TEST(LedStripDriverWeatherTestGroup, resetsRainCounterCorrectly)
@@ -1161,14 +1243,17 @@ TEST(LedStripDriverWeatherTestGroup, resetsRainCounterCorrectly)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = RAIN_INC_DELAY_MS - 1,
-    .weatherRainPosition = 0,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = RAIN_INC_DELAY_MS - 1,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+    },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(0, state.weatherRainCounter);
+  LONGS_EQUAL(0, state.weather.rainCounter);
 }
 
 TEST(LedStripDriverWeatherTestGroup, resetsRainPositionCorrectly)
@@ -1190,14 +1275,17 @@ TEST(LedStripDriverWeatherTestGroup, resetsRainPositionCorrectly)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = RAIN_INC_DELAY_MS - 1,
-    .weatherRainPosition = (uint8_t)WEATHER_TEST_LED_CONFIG.numLeds - 1,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = RAIN_INC_DELAY_MS - 1,
+      .tempFadeDirection = 1,
+      .rainPosition = (uint8_t)(WEATHER_TEST_LED_CONFIG.numLeds - 1),
+    },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(0, state.weatherRainPosition);
+  LONGS_EQUAL(0, state.weather.rainPosition);
 }
 
 TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesWhenRainBandsWrapAround)
@@ -1219,9 +1307,12 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesWhenRainBandsWrapAround)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 2,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 2,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1254,9 +1345,12 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForRainBandsReverseDirec
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1289,9 +1383,12 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForRainBandsIncrementedR
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 1,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 1,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1323,9 +1420,12 @@ TEST(LedStripDriverWeatherTestGroup, usesCorrectColourForRainBands)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1353,9 +1453,12 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForIncreasedRainBandHeig
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1389,9 +1492,12 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForIncreasedRainBandSpac
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1423,14 +1529,17 @@ TEST(LedStripDriverWeatherTestGroup, doesNotIncrementsRainPositionIfCounterLessT
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = RAIN_INC_DELAY_MS - 2,
-    .weatherRainPosition = 0,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = RAIN_INC_DELAY_MS - 2,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+    },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(0, state.weatherRainPosition);
+  LONGS_EQUAL(0, state.weather.rainPosition);
 }
 
 TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForWeatherWarningInitialState)
@@ -1454,11 +1563,14 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForWeatherWarningInitial
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
-    .weatherWarningCounter = 0,
-    .weatherWarningFadeState = fadeIn,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .warningCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+      .warningFadeState = fadeIn,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1489,11 +1601,14 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForWeatherWarningMidFade
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
-    .weatherWarningCounter = WARNING_FADE_IN_MS/2 - 1,
-    .weatherWarningFadeState = fadeIn,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .warningCounter = WARNING_FADE_IN_MS/2 - 1,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+      .warningFadeState = fadeIn,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1522,11 +1637,14 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForWeatherWarningEndOfFa
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
-    .weatherWarningCounter = WARNING_FADE_IN_MS - 2,
-    .weatherWarningFadeState = fadeIn,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .warningCounter = WARNING_FADE_IN_MS - 2,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+      .warningFadeState = fadeIn,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1555,16 +1673,19 @@ TEST(LedStripDriverWeatherTestGroup, incrementsWeatherWarningCounter)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
-    .weatherWarningCounter = 0,
-    .weatherWarningFadeState = fadeIn,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .warningCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+      .warningFadeState = fadeIn,
+    },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(WEATHER_TEST_LED_CONFIG.resolutionMs, state.weatherWarningCounter);
+  LONGS_EQUAL(WEATHER_TEST_LED_CONFIG.resolutionMs, state.weather.warningCounter);
 }
 
 TEST(LedStripDriverWeatherTestGroup, resetsWeatherWarningCounterAfterFadeIn)
@@ -1588,16 +1709,19 @@ TEST(LedStripDriverWeatherTestGroup, resetsWeatherWarningCounterAfterFadeIn)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
-    .weatherWarningCounter = WARNING_FADE_IN_MS-1,
-    .weatherWarningFadeState = fadeIn,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .warningCounter = WARNING_FADE_IN_MS-1,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+      .warningFadeState = fadeIn,
+    },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(0, state.weatherWarningCounter);
+  LONGS_EQUAL(0, state.weather.warningCounter);
 }
 
 TEST(LedStripDriverWeatherTestGroup, reversesWeatherWarningFadeDirectionAfterFadeIn)
@@ -1621,16 +1745,19 @@ TEST(LedStripDriverWeatherTestGroup, reversesWeatherWarningFadeDirectionAfterFad
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
-    .weatherWarningCounter = WARNING_FADE_IN_MS - WEATHER_TEST_LED_CONFIG.resolutionMs,
-    .weatherWarningFadeState = fadeIn,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .warningCounter = WARNING_FADE_IN_MS - WEATHER_TEST_LED_CONFIG.resolutionMs,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+      .warningFadeState = fadeIn,
+    },
   };
 
   driver->onTimerFired(&state, values);
 
-  LONGS_EQUAL(fadeOut, state.weatherWarningFadeState);
+  LONGS_EQUAL(fadeOut, state.weather.warningFadeState);
 }
 
 TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForWeatherWarningMidFadeOutState)
@@ -1655,11 +1782,14 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForWeatherWarningMidFade
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
-    .weatherWarningCounter = WARNING_FADE_OUT_MS/2 - WEATHER_TEST_LED_CONFIG.resolutionMs,
-    .weatherWarningFadeState = fadeOut,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .warningCounter = WARNING_FADE_OUT_MS/2 - WEATHER_TEST_LED_CONFIG.resolutionMs,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+      .warningFadeState = fadeOut,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1688,11 +1818,14 @@ TEST(LedStripDriverWeatherTestGroup, writesCorrectValuesForWeatherWarningDwellTi
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
-    .weatherWarningCounter = WARNING_OFF_DWELL_MS - (2 * WEATHER_TEST_LED_CONFIG.resolutionMs),
-    .weatherWarningFadeState = offDwell,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .warningCounter = WARNING_OFF_DWELL_MS - (2 * WEATHER_TEST_LED_CONFIG.resolutionMs),
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+      .warningFadeState = offDwell,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1721,16 +1854,19 @@ TEST(LedStripDriverWeatherTestGroup, setsWarningFadeStateToFadeInAfterOffDwell)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
-    .weatherWarningCounter = WARNING_OFF_DWELL_MS -  WEATHER_TEST_LED_CONFIG.resolutionMs,
-    .weatherWarningFadeState = offDwell,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .warningCounter = WARNING_OFF_DWELL_MS -  WEATHER_TEST_LED_CONFIG.resolutionMs,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+      .warningFadeState = offDwell,
+    },
   };
 
   driver->onTimerFired(&state, values);
 
-  CHECK_EQUAL(fadeIn, state.weatherWarningFadeState);
+  CHECK_EQUAL(fadeIn, state.weather.warningFadeState);
 }
 
 TEST(LedStripDriverWeatherTestGroup, doesNotDrawRainBandsPastEndOfLedStrip)
@@ -1754,9 +1890,12 @@ TEST(LedStripDriverWeatherTestGroup, doesNotDrawRainBandsPastEndOfLedStrip)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1786,9 +1925,12 @@ TEST(LedStripDriverWeatherTestGroup, doesNotDrawRainBandsPastEndOfLedStripRevers
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1817,11 +1959,14 @@ TEST(LedStripDriverWeatherTestGroup, warningUsesProvidedColour)
 
   led_strip_state_t state = {
     .counter = 0,
-    .weatherTempFadeDirection = 1,
-    .weatherRainCounter = 0,
-    .weatherRainPosition = 0,
-    .weatherWarningCounter = WARNING_FADE_IN_MS,
-    .weatherWarningFadeState = fadeIn,
+    .pattern = Pattern::weather,
+    .weather = {
+      .rainCounter = 0,
+      .warningCounter = WARNING_FADE_IN_MS,
+      .tempFadeDirection = 1,
+      .rainPosition = 0,
+      .warningFadeState = fadeIn,
+    },
   };
 
   driver->onTimerFired(&state, values);
@@ -1850,65 +1995,512 @@ TEST(LedStripDriverInitStateTestGroup, initialisesCounter)
   LONGS_EQUAL(0, state.counter);
 }
 
-TEST(LedStripDriverInitStateTestGroup, initialisesDutyCycle)
+TEST(LedStripDriverInitStateTestGroup, initialisesDutyDirection)
 {
   led_strip_state_t state;
   LedStripDriver driver((led_strip_config_t*)&CONFIG_LEDS_1);
+  driver.pattern(Pattern::pulse);
   driver.initState(&state);
 
-  DOUBLES_EQUAL(1, state.dutyCycle, 0.00001);
+  LONGS_EQUAL(1, state.pulse.direction);
 }
 
-TEST(LedStripDriverInitStateTestGroup, initialisesDutyDirection)
+TEST(LedStripDriverInitStateTestGroup, initialisesProgress)
 {
   led_strip_state_t state;
   LedStripDriver driver((led_strip_config_t*)&CONFIG_LEDS_1);
+  state.progress.step = 5;
+  driver.pattern(Pattern::progress);
   driver.initState(&state);
 
-  LONGS_EQUAL(1, state.dutyDirection);
+  LONGS_EQUAL(0, state.progress.step);
 }
 
 TEST(LedStripDriverInitStateTestGroup, initialisesWeatherTempFadeDirection)
 {
   led_strip_state_t state;
   LedStripDriver driver((led_strip_config_t*)&CONFIG_LEDS_1);
+  driver.pattern(Pattern::weather);
   driver.initState(&state);
 
-  CHECK_EQUAL(1, state.weatherTempFadeDirection);
+  CHECK_EQUAL(1, state.weather.tempFadeDirection);
 }
 
 TEST(LedStripDriverInitStateTestGroup, initialisesWeatherRainCounter)
 {
   led_strip_state_t state;
   LedStripDriver driver((led_strip_config_t*)&CONFIG_LEDS_1);
+  driver.pattern(Pattern::weather);
   driver.initState(&state);
 
-  LONGS_EQUAL(0, state.weatherRainCounter);
+  LONGS_EQUAL(0, state.weather.rainCounter);
 }
 
 TEST(LedStripDriverInitStateTestGroup, initialisesWeatherRainPosition)
 {
   led_strip_state_t state;
   LedStripDriver driver((led_strip_config_t*)&CONFIG_LEDS_1);
+  driver.pattern(Pattern::weather);
   driver.initState(&state);
 
-  CHECK_EQUAL(0, state.weatherRainPosition);
+  CHECK_EQUAL(0, state.weather.rainPosition);
 }
 
 TEST(LedStripDriverInitStateTestGroup, initialisesWeatherWarningCounter)
 {
   led_strip_state_t state;
   LedStripDriver driver((led_strip_config_t*)&CONFIG_LEDS_1);
+  driver.pattern(Pattern::weather);
   driver.initState(&state);
 
-  LONGS_EQUAL(0, state.weatherWarningCounter);
+  LONGS_EQUAL(0, state.weather.warningCounter);
 }
 
 TEST(LedStripDriverInitStateTestGroup, initialisesWeatherWarningFadeState)
 {
   led_strip_state_t state;
   LedStripDriver driver((led_strip_config_t*)&CONFIG_LEDS_1);
+  driver.pattern(Pattern::weather);
   driver.initState(&state);
 
-  LONGS_EQUAL(fadeIn, state.weatherWarningFadeState);
+  LONGS_EQUAL(fadeIn, state.weather.warningFadeState);
+}
+
+TEST(LedStripDriverInitStateTestGroup, tagsStateWithPattern)
+{
+  led_strip_state_t state;
+  LedStripDriver driver((led_strip_config_t*)&CONFIG_LEDS_1);
+  driver.pattern(Pattern::snake);
+  driver.initState(&state);
+
+  LONGS_EQUAL(Pattern::snake, state.pattern);
+}
+
+TEST(LedStripDriverInitStateTestGroup, reinitialisesPatternStateWhenPatternChanges)
+{
+  led_strip_state_t state = {
+    .counter = 0,
+    .pattern = Pattern::progress,
+    .progress = { .step = 5 },
+  };
+  uint8_t values[3];
+  LedStripDriver driver((led_strip_config_t*)&CONFIG_LEDS_1);
+  driver.pattern(Pattern::snake);
+
+  driver.render(&state, values);
+
+  LONGS_EQUAL(Pattern::snake, state.pattern);
+  LONGS_EQUAL(0, state.progress.step);
+}
+
+/***********************************************************************************************
+ * Clocked rendering
+ **********************************************************************************************/
+static uint32_t fakeTimeMs;
+
+static uint32_t fakeTime() {
+  return fakeTimeMs;
+}
+
+static const led_strip_config_t CONFIG_LEDS_3_CLOCKED = {
+  .numLeds = 3,
+  .writeValueFn = writeValueStub,
+  .resolutionMs = 1,
+  .timeFn = fakeTime,
+};
+
+TEST_GROUP(LedStripDriverClockedTestGroup)
+{
+  void setup() {
+    const uint32_t valuesLength = MAX_LEDS * COLOURS_PER_LED;
+
+    fakeTimeMs = 1000;
+    driver = new LedStripDriver((led_strip_config_t*)&CONFIG_LEDS_3_CLOCKED);
+    lastValuesWritten = new uint8_t[valuesLength];
+    memset(lastValuesWritten, 0, valuesLength);
+    memset(values, 0, valuesLength);
+  }
+
+  void teardown() {
+    delete driver;
+    delete[] lastValuesWritten;
+  }
+};
+
+TEST(LedStripDriverClockedTestGroup, initStateTakesTimeFromClock)
+{
+  led_strip_state_t state;
+  driver->initState(&state);
+
+  LONGS_EQUAL(1000, state.timeMs);
+}
+
+TEST(LedStripDriverClockedTestGroup, advancesCounterByElapsedTime)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::colour)->colourOn((Colour*)&COLOUR_ON);
+  driver->initState(&state);
+
+  fakeTimeMs += 7;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(7, state.counter);
+  LONGS_EQUAL(1007, state.timeMs);
+}
+
+TEST(LedStripDriverClockedTestGroup, lateFrameKeepsBlinkInPhase)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::blink)
+    ->period(10)
+    ->dutyCycle(50)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF);
+  driver->initState(&state);
+
+  fakeTimeMs += 23;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(3, state.counter);
+  verify_colours((Colour*)&COLOUR_ON, lastValuesWritten, 3);
+}
+
+TEST(LedStripDriverClockedTestGroup, lateFrameKeepsPulseDirection)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::pulse)
+    ->period(10)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF);
+  driver->initState(&state);
+
+  fakeTimeMs += 15;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(5, state.counter);
+  LONGS_EQUAL(-1, state.pulse.direction);
+}
+
+TEST(LedStripDriverClockedTestGroup, lateFrameCatchesUpSnakeProgress)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::snake)
+    ->period(40)
+    ->length(1)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF);
+  driver->initState(&state);
+
+  fakeTimeMs += 25;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(2, state.progress.step);
+}
+
+TEST(LedStripDriverClockedTestGroup, stalledClockCatchesUpProgress)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::progress)
+    ->initialValue(0)
+    ->finalValue(3)
+    ->increment(1)
+    ->incDelay(500)
+    ->resetDelay(1000)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF);
+  driver->initState(&state);
+
+  fakeTimeMs += 1700;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(3, state.progress.step);
+  LONGS_EQUAL(200, state.counter);
+
+  //a whole 3000ms cycle later it's back at the same point
+  fakeTimeMs += 3000;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(3, state.progress.step);
+  LONGS_EQUAL(200, state.counter);
+}
+
+TEST(LedStripDriverClockedTestGroup, stalledClockWrapsProgressCycle)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::progress)
+    ->initialValue(0)
+    ->finalValue(3)
+    ->increment(1)
+    ->incDelay(500)
+    ->resetDelay(1000)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF);
+  driver->initState(&state);
+
+  fakeTimeMs += 600;
+  driver->onTimerFired(&state, values);
+
+  fakeTimeMs += 3500;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(2, state.progress.step);
+  LONGS_EQUAL(100, state.counter);
+}
+
+TEST(LedStripDriverClockedTestGroup, stalledClockKeepsTemperatureFadeDirection)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::weather)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF)
+    ->tempFadeInterval(1);
+  driver->initState(&state);
+
+  //two whole 999ms fades
+  fakeTimeMs += 2 * 999 + 10;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(1, state.weather.tempFadeDirection);
+  LONGS_EQUAL(10, state.counter);
+
+  fakeTimeMs += 999;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(-1, state.weather.tempFadeDirection);
+}
+
+TEST(LedStripDriverClockedTestGroup, stalledClockCatchesUpRain)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::weather)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF)
+    ->rainBandHeight(1)
+    ->rainBandSpacing(1)
+    ->rainBandIncrementDelay(100);
+  driver->initState(&state);
+
+  fakeTimeMs += 250;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(2, state.weather.rainPosition);
+  LONGS_EQUAL(50, state.weather.rainCounter);
+
+  fakeTimeMs += 100;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(0, state.weather.rainPosition);
+}
+
+TEST(LedStripDriverClockedTestGroup, stalledClockCatchesUpWeatherWarning)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::weather)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF)
+    ->warningFadeIn(100)
+    ->warningFadeOut(100)
+    ->warningOffDwell(100);
+  driver->initState(&state);
+
+  fakeTimeMs += 250;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(offDwell, state.weather.warningFadeState);
+  LONGS_EQUAL(50, state.weather.warningCounter);
+
+  //through the rest of the dwell and the next fade in
+  fakeTimeMs += 170;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(fadeOut, state.weather.warningFadeState);
+  LONGS_EQUAL(20, state.weather.warningCounter);
+}
+
+//units sharing a pattern epoch render the same frames however long after it each joined
+static void verifyInPhase(LedStripDriver *early, LedStripDriver *late) {
+  const uint32_t EPOCH_MS = 1000;
+  led_strip_state_t earlyState;
+  led_strip_state_t lateState;
+  uint8_t earlyValues[MAX_LEDS * COLOURS_PER_LED] = {0};
+  uint8_t lateValues[MAX_LEDS * COLOURS_PER_LED] = {0};
+
+  fakeTimeMs = EPOCH_MS + 5000;
+  early->initState(&earlyState);
+  earlyState.timeMs = EPOCH_MS;
+
+  for (; fakeTimeMs < EPOCH_MS + 3 * 3600 * 1000; fakeTimeMs += 250) {
+    early->render(&earlyState, earlyValues);
+  }
+
+  fakeTimeMs += 7;
+  late->initState(&lateState);
+  lateState.timeMs = EPOCH_MS;
+  early->render(&earlyState, earlyValues);
+  late->render(&lateState, lateValues);
+
+  //a stepped pattern draws a step on the frame after taking it
+  for (uint32_t i=0; i<400; i++) {
+    fakeTimeMs += 25;
+    early->render(&earlyState, earlyValues);
+    late->render(&lateState, lateValues);
+
+    MEMCMP_EQUAL(earlyValues, lateValues, sizeof(earlyValues));
+  }
+}
+
+TEST(LedStripDriverClockedTestGroup, progressInPhaseAcrossUnits)
+{
+  LedStripDriver late((led_strip_config_t*)&CONFIG_LEDS_3_CLOCKED);
+  LedStripDriver *drivers[] = {driver, &late};
+
+  for (LedStripDriver *unit : drivers) {
+    unit->pattern(Pattern::progress)
+      ->initialValue(0)
+      ->finalValue(3)
+      ->increment(1)
+      ->incDelay(700)
+      ->resetDelay(1300)
+      ->colourOn((Colour*)&COLOUR_ON)
+      ->colourOff((Colour*)&COLOUR_OFF);
+  }
+
+  verifyInPhase(driver, &late);
+}
+
+TEST(LedStripDriverClockedTestGroup, weatherInPhaseAcrossUnits)
+{
+  const Colour COLOUR_RAIN = COLOUR_BLUE;
+  LedStripDriver late((led_strip_config_t*)&CONFIG_LEDS_3_CLOCKED);
+  LedStripDriver *drivers[] = {driver, &late};
+
+  for (LedStripDriver *unit : drivers) {
+    unit->pattern(Pattern::weather)
+      ->colourOn((Colour*)&COLOUR_ON)
+      ->colourOff((Colour*)&COLOUR_OFF)
+      ->tempFadeInterval(3)
+      ->rainBandHeight(1)
+      ->rainBandSpacing(1)
+      ->rainBandIncrementDelay(330)
+      ->rainBandColour((Colour*)&COLOUR_RAIN)
+      ->warningFadeIn(900)
+      ->warningFadeOut(700)
+      ->warningOffDwell(1100);
+  }
+
+  verifyInPhase(driver, &late);
+}
+
+TEST(LedStripDriverClockedTestGroup, holdsFirstFrameUntilStartTime)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::colour)->colourOn((Colour*)&COLOUR_ON);
+  driver->initState(&state);
+  state.timeMs = 1100;
+
+  fakeTimeMs = 1050;
+  driver->onTimerFired(&state, values);
+  LONGS_EQUAL(0, state.counter);
+
+  fakeTimeMs = 1120;
+  driver->onTimerFired(&state, values);
+  LONGS_EQUAL(20, state.counter);
+}
+
+/***********************************************************************************************
+ * Next change
+ **********************************************************************************************/
+TEST(LedStripDriverClockedTestGroup, staticPatternsNeverChange)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::colour)->colourOn((Colour*)&COLOUR_ON);
+  driver->initState(&state);
+  driver->onTimerFired(&state, values);
+
+  CHECK(NEXT_CHANGE_NEVER == driver->nextChangeMs(&state));
+}
+
+TEST(LedStripDriverClockedTestGroup, fadingPatternsChangeEveryFrame)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::pulse)
+    ->period(1000)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF);
+  driver->initState(&state);
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(0, driver->nextChangeMs(&state));
+}
+
+TEST(LedStripDriverClockedTestGroup, blinkChangesAtNextEdge)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::blink)
+    ->period(100)
+    ->dutyCycle(50)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF);
+  driver->initState(&state);
+
+  fakeTimeMs += 30;
+  driver->onTimerFired(&state, values);
+  LONGS_EQUAL(20, driver->nextChangeMs(&state));
+
+  fakeTimeMs += 40;
+  driver->onTimerFired(&state, values);
+  LONGS_EQUAL(30, driver->nextChangeMs(&state));
+}
+
+TEST(LedStripDriverClockedTestGroup, progressChangesAfterIncrementDelay)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::progress)
+    ->initialValue(0)
+    ->finalValue(3)
+    ->increment(1)
+    ->incDelay(500)
+    ->resetDelay(1000)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF);
+  driver->initState(&state);
+
+  fakeTimeMs += 100;
+  driver->onTimerFired(&state, values);
+
+  LONGS_EQUAL(400, driver->nextChangeMs(&state));
+}
+
+TEST(LedStripDriverClockedTestGroup, steppedPatternRedrawsOnNextFrame)
+{
+  led_strip_state_t state;
+
+  driver->pattern(Pattern::snake)
+    ->period(400)
+    ->length(1)
+    ->colourOn((Colour*)&COLOUR_ON)
+    ->colourOff((Colour*)&COLOUR_OFF);
+  driver->initState(&state);
+
+  fakeTimeMs += 110;
+  driver->onTimerFired(&state, values);
+  LONGS_EQUAL(0, driver->nextChangeMs(&state));
+
+  fakeTimeMs += 1;
+  driver->onTimerFired(&state, values);
+  LONGS_EQUAL(89, driver->nextChangeMs(&state));
 }
@@ -0,0 +1,198 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "pixelMap.h"
+#include "config.h"
+
+#define MAX_LEDS 10
+
+static uint16_t map[MAX_LEDS];
+
+static void verify_map(const uint16_t *expected, uint32_t len) {
+  for (uint32_t i=0; i<len; i++) {
+    LONGS_EQUAL(expected[i], map[i]);
+  }
+}
+
+TEST_GROUP(PixelMapTestGroup)
+{
+  void setup() {
+    memset(map, 0xFF, sizeof(map));
+  }
+};
+
+TEST(PixelMapTestGroup, buildsIdentityMapForDefaultLayout)
+{
+  const pixel_map_config_t config = { .numLeds = 5 };
+  const uint16_t expected[] = {0, 1, 2, 3, 4};
+
+  LONGS_EQUAL(5, pixelMap::build(map, &config));
+  verify_map(expected, 5);
+}
+
+TEST(PixelMapTestGroup, buildsReversedMap)
+{
+  const pixel_map_config_t config = { .numLeds = 5, .offset = 0, .reverse = true };
+  const uint16_t expected[] = {4, 3, 2, 1, 0};
+
+  LONGS_EQUAL(5, pixelMap::build(map, &config));
+  verify_map(expected, 5);
+}
+
+TEST(PixelMapTestGroup, buildsOffsetMap)
+{
+  const pixel_map_config_t config = { .numLeds = 5, .offset = 2 };
+  const uint16_t expected[] = {3, 4, 0, 1, 2};
+
+  LONGS_EQUAL(5, pixelMap::build(map, &config));
+  verify_map(expected, 5);
+}
+
+TEST(PixelMapTestGroup, buildsSerpentineMap)
+{
+  const pixel_map_config_t config = {
+    .numLeds = 8,
+    .offset = 0,
+    .reverse = false,
+    .serpentineWidth = 3,
+  };
+  const uint16_t expected[] = {0, 1, 2, 5, 4, 3, 6, 7};
+
+  LONGS_EQUAL(8, pixelMap::build(map, &config));
+  verify_map(expected, 8);
+}
+
+TEST(PixelMapTestGroup, buildsSerpentineMapWithPartialOddRow)
+{
+  const pixel_map_config_t config = {
+    .numLeds = 5,
+    .offset = 0,
+    .reverse = false,
+    .serpentineWidth = 3,
+  };
+  const uint16_t expected[] = {0, 1, 2, 4, 3};
+
+  LONGS_EQUAL(5, pixelMap::build(map, &config));
+  verify_map(expected, 5);
+}
+
+TEST(PixelMapTestGroup, buildsMirroredMapForOddLength)
+{
+  const pixel_map_config_t config = {
+    .numLeds = 5,
+    .offset = 0,
+    .reverse = false,
+    .serpentineWidth = 0,
+    .mirror = true,
+  };
+  const uint16_t expected[] = {0, 1, 2, 1, 0};
+
+  LONGS_EQUAL(3, pixelMap::build(map, &config));
+  verify_map(expected, 5);
+}
+
+TEST(PixelMapTestGroup, buildsMirroredMapForEvenLength)
+{
+  const pixel_map_config_t config = {
+    .numLeds = 6,
+    .offset = 0,
+    .reverse = false,
+    .serpentineWidth = 0,
+    .mirror = true,
+  };
+  const uint16_t expected[] = {0, 1, 2, 2, 1, 0};
+
+  LONGS_EQUAL(3, pixelMap::build(map, &config));
+  verify_map(expected, 6);
+}
+
+TEST(PixelMapTestGroup, buildsRepeatedMap)
+{
+  const pixel_map_config_t config = {
+    .numLeds = 7,
+    .offset = 0,
+    .reverse = false,
+    .serpentineWidth = 0,
+    .mirror = false,
+    .repeat = 3,
+  };
+  const uint16_t expected[] = {0, 1, 2, 0, 1, 2, 0};
+
+  LONGS_EQUAL(3, pixelMap::build(map, &config));
+  verify_map(expected, 7);
+}
+
+TEST(PixelMapTestGroup, ignoresRepeatLongerThanStrip)
+{
+  const pixel_map_config_t config = {
+    .numLeds = 4,
+    .offset = 0,
+    .reverse = false,
+    .serpentineWidth = 0,
+    .mirror = false,
+    .repeat = 10,
+  };
+  const uint16_t expected[] = {0, 1, 2, 3};
+
+  LONGS_EQUAL(4, pixelMap::build(map, &config));
+  verify_map(expected, 4);
+}
+
+TEST(PixelMapTestGroup, appliesOffsetBeforeReverse)
+{
+  const pixel_map_config_t config = { .numLeds = 5, .offset = 1, .reverse = true };
+  const uint16_t expected[] = {0, 4, 3, 2, 1};
+
+  pixelMap::build(map, &config);
+  verify_map(expected, 5);
+}
+
+TEST(PixelMapTestGroup, gathersValuesIntoPhysicalOrder)
+{
+  const uint16_t ledMap[] = {2, 0, 1, 0};
+  const uint8_t values[] = {
+    1, 2, 3,
+    4, 5, 6,
+    7, 8, 9,
+  };
+  const uint8_t expected[] = {
+    7, 8, 9,
+    1, 2, 3,
+    4, 5, 6,
+    1, 2, 3,
+  };
+  uint8_t output[4 * COLOURS_PER_LED];
+
+  pixelMap::apply(output, values, ledMap, 4);
+
+  for (uint32_t i=0; i < sizeof(expected); i++) {
+    BYTES_EQUAL(expected[i], output[i]);
+  }
+}
+
+TEST(PixelMapTestGroup, swizzlesChannelsIntoEachColourOrder)
+{
+  const uint16_t ledMap[] = {1, 0};
+  const uint8_t values[] = {
+    1, 2, 3,
+    4, 5, 6,
+  };
+  const uint8_t expected[][6] = {
+    {4, 5, 6, 1, 2, 3}, /* orderRgb */
+    {4, 6, 5, 1, 3, 2}, /* orderRbg */
+    {5, 4, 6, 2, 1, 3}, /* orderGrb */
+    {5, 6, 4, 2, 3, 1}, /* orderGbr */
+    {6, 4, 5, 3, 1, 2}, /* orderBrg */
+    {6, 5, 4, 3, 2, 1}, /* orderBgr */
+  };
+  const ColourOrder ORDERS[] = {orderRgb, orderRbg, orderGrb, orderGbr, orderBrg, orderBgr};
+  uint8_t output[2 * COLOURS_PER_LED];
+
+  for (uint32_t i=0; i < sizeof(ORDERS)/sizeof(ORDERS[0]); i++) {
+    pixelMap::apply(output, values, ledMap, 2, ORDERS[i]);
+
+    for (uint32_t j=0; j < sizeof(output); j++) {
+      BYTES_EQUAL(expected[i][j], output[j]);
+    }
+  }
+}
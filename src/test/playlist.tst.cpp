@@ -0,0 +1,173 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+#include <cstring>
+
+#include "argParser.h"
+#include "playlist.h"
+
+using namespace argParser;
+
+static const ArgInfo ARGS_INFO_TEST[] = {
+  { .type = ARG_TYPE_NUMBER, .min = 0, .max = 100000 },
+  { .type = ARG_TYPE_COLOUR },
+};
+
+static const ArgConfig ARG_CONFIG_TEST = {
+  .info = ARGS_INFO_TEST,
+  .length = 2,
+};
+
+static const uint32_t VALUES_A[] = {1000, 0xFF0000};
+static const uint32_t VALUES_B[] = {50000, 0x00FF00};
+
+static playlist_store_t store;
+static Playlist *playlist;
+
+TEST_GROUP(PlaylistTestGroup)
+{
+  void setup() {
+    memset(&store, 0, sizeof(store));
+    playlist = new Playlist(&store);
+    playlist->clear();
+  }
+
+  void teardown() {
+    delete playlist;
+  }
+};
+
+TEST(PlaylistTestGroup, storesEntries)
+{
+  playlist_entry_t entry;
+  uint32_t values[2];
+
+  CHECK(playlist->add(3, &ARG_CONFIG_TEST, VALUES_A, 2000, 500));
+  CHECK(playlist->add(5, &ARG_CONFIG_TEST, VALUES_B, 3000, 0));
+
+  LONGS_EQUAL(2, playlist->length());
+
+  playlist->entry(1, &entry);
+  unpackArgs(values, &ARG_CONFIG_TEST, entry.args);
+
+  LONGS_EQUAL(5, entry.command);
+  LONGS_EQUAL(3000, entry.durationMs);
+  LONGS_EQUAL(0, entry.transitionMs);
+  LONGS_EQUAL(VALUES_B[0], values[0]);
+  LONGS_EQUAL(VALUES_B[1], values[1]);
+}
+
+TEST(PlaylistTestGroup, packsEntriesCompactly)
+{
+  playlist->add(3, &ARG_CONFIG_TEST, VALUES_A, 2000, 500);
+
+  //7 byte header, 4 byte number, 3 byte colour
+  LONGS_EQUAL(14, store.used);
+}
+
+TEST(PlaylistTestGroup, rejectsEntriesWhenFull)
+{
+  for (uint32_t i=0; i < PLAYLIST_ENTRIES_MAX; i++) {
+    CHECK(playlist->add(0, &ARG_CONFIG_TEST, VALUES_A, 1000, 0));
+  }
+
+  CHECK_FALSE(playlist->add(0, &ARG_CONFIG_TEST, VALUES_A, 1000, 0));
+  LONGS_EQUAL(PLAYLIST_ENTRIES_MAX, playlist->length());
+}
+
+TEST(PlaylistTestGroup, entersFirstEntryOnFirstTick)
+{
+  playlist->add(0, &ARG_CONFIG_TEST, VALUES_A, 100, 0);
+  playlist->add(1, &ARG_CONFIG_TEST, VALUES_B, 100, 0);
+  playlist->start();
+
+  LONGS_EQUAL(0, playlist->tick(10));
+  LONGS_EQUAL(-1, playlist->tick(10));
+}
+
+TEST(PlaylistTestGroup, advancesAfterEntryDuration)
+{
+  playlist->add(0, &ARG_CONFIG_TEST, VALUES_A, 100, 0);
+  playlist->add(1, &ARG_CONFIG_TEST, VALUES_B, 50, 0);
+  playlist->start();
+  playlist->tick(10);
+
+  for (uint32_t i=0; i < 9; i++) {
+    LONGS_EQUAL(-1, playlist->tick(10));
+  }
+
+  LONGS_EQUAL(1, playlist->tick(10));
+}
+
+TEST(PlaylistTestGroup, wrapsToFirstEntry)
+{
+  playlist->add(0, &ARG_CONFIG_TEST, VALUES_A, 20, 0);
+  playlist->add(1, &ARG_CONFIG_TEST, VALUES_B, 20, 0);
+  playlist->start();
+  playlist->tick(10);
+
+  playlist->tick(10);
+  LONGS_EQUAL(1, playlist->tick(10));
+  playlist->tick(10);
+  LONGS_EQUAL(0, playlist->tick(10));
+}
+
+TEST(PlaylistTestGroup, carriesOvershootIntoNextEntry)
+{
+  playlist->add(0, &ARG_CONFIG_TEST, VALUES_A, 25, 0);
+  playlist->add(1, &ARG_CONFIG_TEST, VALUES_B, 25, 0);
+  playlist->start();
+  playlist->tick(10);
+
+  playlist->tick(10);
+  playlist->tick(10);
+  LONGS_EQUAL(1, playlist->tick(10));
+  playlist->tick(10);
+  LONGS_EQUAL(0, playlist->tick(10));
+}
+
+TEST(PlaylistTestGroup, doesNotTickWhenStopped)
+{
+  playlist->add(0, &ARG_CONFIG_TEST, VALUES_A, 10, 0);
+  playlist->start();
+  playlist->stop();
+
+  LONGS_EQUAL(-1, playlist->tick(10));
+  CHECK_FALSE(playlist->isRunning());
+}
+
+TEST(PlaylistTestGroup, doesNotStartWhenEmpty)
+{
+  playlist->start();
+
+  CHECK_FALSE(playlist->isRunning());
+  LONGS_EQUAL(-1, playlist->tick(10));
+}
+
+TEST(PlaylistTestGroup, isValidAfterClear)
+{
+  CHECK(playlist->isValid());
+}
+
+TEST(PlaylistTestGroup, isNotValidForUninitialisedStore)
+{
+  memset(&store, 0xFF, sizeof(store));
+
+  CHECK_FALSE(playlist->isValid());
+}
+
+TEST(PlaylistTestGroup, entryFitsWithinUsedBytes)
+{
+  playlist->add(3, &ARG_CONFIG_TEST, VALUES_A, 2000, 500);
+
+  CHECK(playlist->entryFits(0, &ARG_CONFIG_TEST));
+}
+
+TEST(PlaylistTestGroup, entryArgsPastUsedBytesDoNotFit)
+{
+  playlist->add(3, &ARG_CONFIG_TEST, VALUES_A, 2000, 500);
+  store.used -= 1;
+
+  //the header alone still fits
+  CHECK(playlist->isValid());
+  CHECK_FALSE(playlist->entryFits(0, &ARG_CONFIG_TEST));
+}
@@ -0,0 +1,151 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+#include <cstring>
+
+#include "profiler.h"
+
+TEST_GROUP(Log2HistogramTestGroup)
+{
+  Log2Histogram *histogram;
+
+  void setup() {
+    histogram = new Log2Histogram();
+  }
+
+  void teardown() {
+    delete histogram;
+  }
+};
+
+TEST(Log2HistogramTestGroup, binsByPowerOfTwo)
+{
+  LONGS_EQUAL(0, Log2Histogram::binOf(0));
+  LONGS_EQUAL(1, Log2Histogram::binOf(1));
+  LONGS_EQUAL(2, Log2Histogram::binOf(2));
+  LONGS_EQUAL(2, Log2Histogram::binOf(3));
+  LONGS_EQUAL(3, Log2Histogram::binOf(4));
+  LONGS_EQUAL(11, Log2Histogram::binOf(1500));
+}
+
+TEST(Log2HistogramTestGroup, lastBinHoldsLargeValues)
+{
+  LONGS_EQUAL(HISTOGRAM_BINS - 1, Log2Histogram::binOf(0xFFFFFFFF));
+}
+
+TEST(Log2HistogramTestGroup, countsValues)
+{
+  histogram->add(5);
+  histogram->add(6);
+  histogram->add(100);
+
+  LONGS_EQUAL(3, histogram->count());
+  LONGS_EQUAL(2, histogram->bin(3));
+  LONGS_EQUAL(1, histogram->bin(7));
+  LONGS_EQUAL(100, histogram->max());
+}
+
+TEST(Log2HistogramTestGroup, percentileIsUpperBoundOfBin)
+{
+  for (uint32_t i=0; i<99; i++) {
+    histogram->add(10);
+  }
+  histogram->add(3000);
+
+  LONGS_EQUAL(16, histogram->percentile(50));
+  LONGS_EQUAL(16, histogram->percentile(99));
+  LONGS_EQUAL(4096, histogram->percentile(100));
+}
+
+TEST(Log2HistogramTestGroup, percentileOfEmptyIsZero)
+{
+  LONGS_EQUAL(0, histogram->percentile(50));
+}
+
+TEST(Log2HistogramTestGroup, halvesCountsWhenBinFills)
+{
+  for (uint32_t i=0; i<0xFFFF; i++) {
+    histogram->add(1);
+  }
+  histogram->add(8);
+  histogram->add(8);
+  histogram->add(1);
+
+  LONGS_EQUAL(0x8000, histogram->bin(1));
+  LONGS_EQUAL(1, histogram->bin(4));
+}
+
+TEST_GROUP(RenderProfileTestGroup)
+{
+  RenderProfile *profile;
+
+  void setup() {
+    profile = new RenderProfile();
+  }
+
+  void teardown() {
+    delete profile;
+  }
+};
+
+TEST(RenderProfileTestGroup, splitsFrameIntoRenderAndWrite)
+{
+  profile->frameStart(1000);
+  profile->writeStart(1000 + 300 * CYCLES_PER_US);
+  profile->writeEnd(1000 + 1300 * CYCLES_PER_US);
+  profile->frameEnd(Pattern::snake, 1000 + 1400 * CYCLES_PER_US);
+
+  LONGS_EQUAL(400, profile->render(Pattern::snake)->max());
+  LONGS_EQUAL(1000, profile->write(Pattern::snake)->max());
+  LONGS_EQUAL(0, profile->render(Pattern::pulse)->count());
+}
+
+TEST(RenderProfileTestGroup, handlesCounterWrap)
+{
+  profile->frameStart(0xFFFFFFFF - 50 * CYCLES_PER_US + 1);
+  profile->frameEnd(Pattern::pulse, 50 * CYCLES_PER_US);
+
+  LONGS_EQUAL(100, profile->render(Pattern::pulse)->max());
+}
+
+TEST(RenderProfileTestGroup, summarisesPatternsWithFrames)
+{
+  char summary[PROFILE_SUMMARY_SIZE];
+
+  profile->frameStart(0);
+  profile->writeStart(0);
+  profile->writeEnd(1000 * CYCLES_PER_US);
+  profile->frameEnd(Pattern::pulse, 1100 * CYCLES_PER_US);
+
+  profile->summary(summary, sizeof(summary));
+
+  STRCMP_EQUAL("pulse:r128,128,100w1024,1024,1000 ", summary);
+}
+
+TEST(RenderProfileTestGroup, summaryDropsPatternsThatDoNotFit)
+{
+  char summary[40];
+
+  for (uint32_t i=0; i<PROFILE_PATTERN_COUNT; i++) {
+    profile->frameStart(0);
+    profile->frameEnd(i, 10 * CYCLES_PER_US);
+  }
+
+  LONGS_EQUAL(strlen("blink:r16,16,10w1,1,0 "), profile->summary(summary, sizeof(summary)));
+  STRCMP_EQUAL("blink:r16,16,10w1,1,0 ", summary);
+}
+
+TEST_GROUP(CycleCounterTestGroup)
+{
+};
+
+TEST(CycleCounterTestGroup, countsUp)
+{
+  const uint32_t start = cycleCounter::now();
+  volatile uint32_t sum = 0;
+
+  for (uint32_t i=0; i<1000000; i++) {
+    sum += i;
+  }
+
+  CHECK(cycleCounter::now() - start > 0);
+}
@@ -0,0 +1,173 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "argParser.h"
+#include "scheduler.h"
+
+using namespace argParser;
+
+static const ArgInfo ARGS_INFO_TEST[] = {
+  { .type = ARG_TYPE_NUMBER, .min = 0, .max = 1000 },
+};
+
+static const ArgConfig ARG_CONFIG_TEST = {
+  .info = ARGS_INFO_TEST,
+  .length = 1,
+};
+
+static Scheduler *scheduler;
+
+static void add(uint32_t id, uint32_t time, uint32_t repeatSecs = 0) {
+  const uint32_t values[] = { id };
+
+  CHECK(scheduler->add(0, &ARG_CONFIG_TEST, values, time, repeatSecs));
+}
+
+static uint32_t nextId(uint32_t now) {
+  schedule_entry_t entry;
+  uint32_t values[1];
+
+  if (!scheduler->next(now, &entry)) {
+    return 0;
+  }
+
+  unpackArgs(values, &ARG_CONFIG_TEST, entry.args);
+
+  return values[0];
+}
+
+TEST_GROUP(SchedulerTestGroup)
+{
+  void setup() {
+    scheduler = new Scheduler();
+  }
+
+  void teardown() {
+    delete scheduler;
+  }
+};
+
+TEST(SchedulerTestGroup, returnsNothingWhenEmpty)
+{
+  LONGS_EQUAL(0, nextId(1000));
+}
+
+TEST(SchedulerTestGroup, returnsNothingBeforeDueTime)
+{
+  add(1, 100);
+
+  LONGS_EQUAL(0, nextId(99));
+  LONGS_EQUAL(1, scheduler->length());
+}
+
+TEST(SchedulerTestGroup, returnsEntryAtDueTime)
+{
+  add(1, 100);
+
+  LONGS_EQUAL(1, nextId(100));
+  LONGS_EQUAL(0, scheduler->length());
+}
+
+TEST(SchedulerTestGroup, returnsEntriesInTimeOrder)
+{
+  add(3, 300);
+  add(1, 100);
+  add(4, 400);
+  add(2, 200);
+
+  LONGS_EQUAL(1, nextId(1000));
+  LONGS_EQUAL(2, nextId(1000));
+  LONGS_EQUAL(3, nextId(1000));
+  LONGS_EQUAL(4, nextId(1000));
+  LONGS_EQUAL(0, nextId(1000));
+}
+
+TEST(SchedulerTestGroup, reschedulesRepeatingEntries)
+{
+  add(1, 100, 50);
+
+  LONGS_EQUAL(1, nextId(100));
+  LONGS_EQUAL(0, nextId(149));
+  LONGS_EQUAL(1, nextId(150));
+  LONGS_EQUAL(1, scheduler->length());
+}
+
+TEST(SchedulerTestGroup, skipsMissedRepeats)
+{
+  add(1, 100, 50);
+
+  LONGS_EQUAL(1, nextId(320));
+  LONGS_EQUAL(0, nextId(349));
+  LONGS_EQUAL(1, nextId(350));
+}
+
+TEST(SchedulerTestGroup, interleavesRepeatingAndSingleEntries)
+{
+  add(1, 100, 100);
+  add(2, 150);
+
+  LONGS_EQUAL(1, nextId(100));
+  LONGS_EQUAL(2, nextId(200));
+  LONGS_EQUAL(1, nextId(200));
+  LONGS_EQUAL(0, nextId(200));
+}
+
+TEST(SchedulerTestGroup, rejectsEntriesWhenFull)
+{
+  const uint32_t values[] = { 1 };
+
+  for (uint32_t i=0; i < SCHEDULE_ENTRIES_MAX; i++) {
+    add(1, i);
+  }
+
+  CHECK_FALSE(scheduler->add(0, &ARG_CONFIG_TEST, values, 0, 0));
+}
+
+TEST(SchedulerTestGroup, clearRemovesEntries)
+{
+  add(1, 100);
+  scheduler->clear();
+
+  LONGS_EQUAL(0, nextId(1000));
+}
+
+TEST(SchedulerTestGroup, loadsSavedStore)
+{
+  Scheduler restored;
+
+  add(1, 300);
+  add(2, 100, 50);
+  add(3, 125);
+
+  CHECK(restored.load(scheduler->store()));
+  delete scheduler;
+  scheduler = new Scheduler(restored);
+
+  LONGS_EQUAL(3, scheduler->length());
+  LONGS_EQUAL(2, nextId(100));
+  LONGS_EQUAL(3, nextId(140));
+  LONGS_EQUAL(2, nextId(150));
+  LONGS_EQUAL(2, nextId(300));
+  LONGS_EQUAL(1, nextId(300));
+}
+
+TEST(SchedulerTestGroup, loadRejectsInvalidStore)
+{
+  schedule_store_t store;
+  memset(&store, 0xFF, sizeof(store));
+
+  add(1, 100);
+
+  CHECK_FALSE(scheduler->load(&store));
+  LONGS_EQUAL(0, scheduler->length());
+}
+
+TEST(SchedulerTestGroup, nextDailyTimeIsLaterToday)
+{
+  LONGS_EQUAL(2 * SECONDS_PER_DAY + 500, Scheduler::nextDailyTime(2 * SECONDS_PER_DAY + 100, 500));
+}
+
+TEST(SchedulerTestGroup, nextDailyTimeIsTomorrowOncePassed)
+{
+  LONGS_EQUAL(3 * SECONDS_PER_DAY + 500, Scheduler::nextDailyTime(2 * SECONDS_PER_DAY + 500, 500));
+}
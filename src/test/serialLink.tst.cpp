@@ -0,0 +1,278 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "serialLink.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define TIMEOUT_MS 1000
+
+/* The device end of a pseudo terminal, standing in for USB serial */
+class PtyPort {
+private:
+  int mFd;
+
+public:
+  PtyPort(int fd) : mFd(fd) {}
+
+  int available() {
+    int bytes = 0;
+    ioctl(mFd, FIONREAD, &bytes);
+    return bytes;
+  }
+
+  int read() {
+    uint8_t byte;
+    return ::read(mFd, &byte, 1) == 1 ? byte : -1;
+  }
+
+  size_t write(const uint8_t *buffer, size_t length) {
+    return ::write(mFd, buffer, length);
+  }
+};
+
+static int host;
+static int device;
+static PtyPort *port;
+static SerialLink *serialLink;
+static uint8_t frame[DMX_UNIVERSE_SLOTS + SERIAL_LINK_OVERHEAD];
+static uint8_t output[8];
+static char commandName[32];
+static char commandArgs[32];
+
+static int32_t runCommand(const char *name, const char *args) {
+  strncpy(commandName, name, sizeof(commandName) - 1);
+  strncpy(commandArgs, args, sizeof(commandArgs) - 1);
+  return strcmp(name, "colour") == 0 ? 0 : SERIAL_LINK_UNKNOWN_COMMAND;
+}
+
+static void hostWrite(const uint8_t *bytes, uint32_t length) {
+  while (length > 0) {
+    const ssize_t written = write(host, bytes, length);
+    CHECK(written > 0);
+    bytes += written;
+    length -= written;
+  }
+}
+
+static void sendFrame(uint8_t type, const void *payload, uint16_t length) {
+  hostWrite(frame, SerialLink::encode(frame, type, (const uint8_t*)payload, length));
+}
+
+//the pty delivers bytes asynchronously, poll until the expected frames have been parsed
+static void pollUntil(uint32_t bytes) {
+  uint32_t parsed = 0;
+
+  for (uint32_t i=0; i<1000 && parsed < bytes; i++) {
+    const uint32_t polled = serialLink->poll(port, 0);
+
+    parsed += polled;
+
+    if (polled == 0) {
+      usleep(100);
+    }
+  }
+
+  LONGS_EQUAL(bytes, parsed);
+}
+
+static void openPty() {
+  host = posix_openpt(O_RDWR | O_NOCTTY);
+  CHECK(host >= 0);
+  CHECK(grantpt(host) == 0);
+  CHECK(unlockpt(host) == 0);
+
+  device = open(ptsname(host), O_RDWR | O_NOCTTY | O_NONBLOCK);
+  CHECK(device >= 0);
+
+  //binary, no echo or line editing
+  struct termios attrs;
+  tcgetattr(device, &attrs);
+  cfmakeraw(&attrs);
+  tcsetattr(device, TCSANOW, &attrs);
+}
+
+TEST_GROUP(SerialLinkTestGroup)
+{
+  void setup() {
+    openPty();
+    port = new PtyPort(device);
+    serialLink = new SerialLink(runCommand, TIMEOUT_MS);
+    memset(output, 0xAA, sizeof(output));
+    memset(commandName, 0, sizeof(commandName));
+    memset(commandArgs, 0, sizeof(commandArgs));
+  }
+
+  void teardown() {
+    delete serialLink;
+    delete port;
+    close(device);
+    close(host);
+  }
+};
+
+TEST(SerialLinkTestGroup, encodesFrame)
+{
+  const uint8_t payload[] = {1, 2, 3};
+  const uint8_t expected[] = {0xA5, 0x5A, 0x01, 0x03, 0x00, 1, 2, 3, 0xC4, 0x53};
+
+  LONGS_EQUAL(sizeof(expected), SerialLink::encode(frame, serialFrameSlots, payload, sizeof(payload)));
+  MEMCMP_EQUAL(expected, frame, sizeof(expected));
+}
+
+TEST(SerialLinkTestGroup, receivesSlots)
+{
+  const uint8_t slots[] = {10, 20, 30, 40};
+  sendFrame(serialFrameSlots, slots, sizeof(slots));
+
+  pollUntil(sizeof(slots) + SERIAL_LINK_OVERHEAD);
+
+  LONGS_EQUAL(1, serialLink->stats()->frames);
+  LONGS_EQUAL(3, serialLink->read(output, 1, 4));
+  BYTES_EQUAL(20, output[0]);
+  BYTES_EQUAL(40, output[2]);
+  BYTES_EQUAL(0, output[3]);
+  CHECK_TRUE(serialLink->isLive(0));
+  CHECK_FALSE(serialLink->isLive(TIMEOUT_MS));
+}
+
+TEST(SerialLinkTestGroup, parsesFrameSplitAcrossReads)
+{
+  const uint8_t slots[] = {10, 20, 30, 40};
+  const uint32_t length = SerialLink::encode(frame, serialFrameSlots, slots, sizeof(slots));
+
+  for (uint32_t i=0; i<length; i++) {
+    LONGS_EQUAL(i == length - 1 ? serialFrameSlots : 0, serialLink->consume(frame[i], 0));
+  }
+}
+
+TEST(SerialLinkTestGroup, skipsNoiseBeforeSync)
+{
+  const uint8_t noise[] = {'h', 'i', 0xA5, 0xA5};
+  const uint8_t slots[] = {1};
+  hostWrite(noise, sizeof(noise));
+  sendFrame(serialFrameSlots, slots, sizeof(slots));
+
+  pollUntil(sizeof(noise) + sizeof(slots) + SERIAL_LINK_OVERHEAD);
+
+  LONGS_EQUAL(1, serialLink->stats()->frames);
+}
+
+TEST(SerialLinkTestGroup, dropsCorruptFrames)
+{
+  const uint8_t slots[] = {10, 20, 30, 40};
+  const uint32_t length = SerialLink::encode(frame, serialFrameSlots, slots, sizeof(slots));
+  frame[6] ^= 0x01;
+  hostWrite(frame, length);
+
+  pollUntil(length);
+
+  LONGS_EQUAL(0, serialLink->stats()->frames);
+  LONGS_EQUAL(1, serialLink->stats()->crcErrors);
+  LONGS_EQUAL(0, serialLink->read(output, 0, 4));
+}
+
+TEST(SerialLinkTestGroup, corruptFrameKeepsLastFrame)
+{
+  const uint8_t first[] = {1, 2};
+  const uint8_t second[] = {3, 4};
+  sendFrame(serialFrameSlots, first, sizeof(first));
+  const uint32_t length = SerialLink::encode(frame, serialFrameSlots, second, sizeof(second));
+  frame[length - 1] ^= 0xFF;
+  hostWrite(frame, length);
+
+  pollUntil(2 * (2 + SERIAL_LINK_OVERHEAD));
+
+  serialLink->read(output, 0, 2);
+  BYTES_EQUAL(1, output[0]);
+}
+
+TEST(SerialLinkTestGroup, rejectsOversizedFrames)
+{
+  const uint8_t header[] = {0xA5, 0x5A, serialFrameSlots, 0x01, 0x02};
+  const uint8_t slots[] = {7};
+  hostWrite(header, sizeof(header));
+  sendFrame(serialFrameSlots, slots, sizeof(slots));
+
+  pollUntil(sizeof(header) + sizeof(slots) + SERIAL_LINK_OVERHEAD);
+
+  LONGS_EQUAL(1, serialLink->stats()->formatErrors);
+  LONGS_EQUAL(1, serialLink->stats()->frames);
+}
+
+TEST(SerialLinkTestGroup, rejectsUnknownTypes)
+{
+  const uint8_t payload[] = {1};
+  const uint32_t length = SerialLink::encode(frame, 0x7F, payload, sizeof(payload));
+  hostWrite(frame, length);
+
+  pollUntil(length);
+
+  LONGS_EQUAL(1, serialLink->stats()->formatErrors);
+}
+
+TEST(SerialLinkTestGroup, runsCommandAndReplies)
+{
+  const char command[] = "colour\0#ff0000";
+  sendFrame(serialFrameCommand, command, sizeof(command) - 1);
+
+  pollUntil(sizeof(command) - 1 + SERIAL_LINK_OVERHEAD);
+
+  STRCMP_EQUAL("colour", commandName);
+  STRCMP_EQUAL("#ff0000", commandArgs);
+  LONGS_EQUAL(1, serialLink->stats()->commands);
+
+  uint8_t reply[4 + SERIAL_LINK_OVERHEAD];
+  const uint8_t result[] = {0, 0, 0, 0};
+  uint8_t expected[sizeof(reply)];
+  SerialLink::encode(expected, serialFrameReply, result, sizeof(result));
+
+  usleep(1000);
+  LONGS_EQUAL(sizeof(reply), read(host, reply, sizeof(reply)));
+  MEMCMP_EQUAL(expected, reply, sizeof(reply));
+}
+
+TEST(SerialLinkTestGroup, commandWithoutArguments)
+{
+  const char command[] = "blink";
+  sendFrame(serialFrameCommand, command, sizeof(command) - 1);
+
+  pollUntil(sizeof(command) - 1 + SERIAL_LINK_OVERHEAD);
+
+  STRCMP_EQUAL("blink", commandName);
+  STRCMP_EQUAL("", commandArgs);
+}
+
+TEST(SerialLinkTestGroup, repliesWithResult)
+{
+  const char command[] = "missing";
+  sendFrame(serialFrameCommand, command, sizeof(command) - 1);
+
+  pollUntil(sizeof(command) - 1 + SERIAL_LINK_OVERHEAD);
+
+  uint8_t reply[4 + SERIAL_LINK_OVERHEAD];
+  usleep(1000);
+  LONGS_EQUAL(sizeof(reply), read(host, reply, sizeof(reply)));
+
+  const int32_t result = reply[5] | (reply[6] << 8) | (reply[7] << 16) | (reply[8] << 24);
+  LONGS_EQUAL(SERIAL_LINK_UNKNOWN_COMMAND, result);
+}
+
+TEST(SerialLinkTestGroup, streamsFullUniversesAt44Hz)
+{
+  uint8_t slots[DMX_UNIVERSE_SLOTS];
+
+  for (uint32_t i=0; i<44; i++) {
+    memset(slots, i, sizeof(slots));
+    sendFrame(serialFrameSlots, slots, sizeof(slots));
+    pollUntil(sizeof(slots) + SERIAL_LINK_OVERHEAD);
+  }
+
+  LONGS_EQUAL(44, serialLink->stats()->frames);
+  serialLink->read(output, DMX_UNIVERSE_SLOTS - 1, 1);
+  BYTES_EQUAL(43, output[0]);
+}
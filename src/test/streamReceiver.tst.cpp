@@ -0,0 +1,309 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "streamReceiver.h"
+
+#define UNIVERSE 7
+#define TIMEOUT_MS 2500
+#define LOOPBACK_QUEUE 4
+
+/* Stands in for Particle's UDP, datagrams sent to it are received in order */
+class LoopbackSocket {
+private:
+  uint8_t mDatagrams[LOOPBACK_QUEUE][STREAM_PACKET_MAX];
+  uint32_t mLengths[LOOPBACK_QUEUE];
+  uint32_t mHead;
+  uint32_t mCount;
+
+public:
+  LoopbackSocket() : mHead(0), mCount(0) {}
+
+  void send(const uint8_t *packet, uint32_t length) {
+    const uint32_t tail = (mHead + mCount) % LOOPBACK_QUEUE;
+
+    memcpy(mDatagrams[tail], packet, length);
+    mLengths[tail] = length;
+    mCount++;
+  }
+
+  //like UDP, a datagram larger than the buffer is truncated
+  int receivePacket(uint8_t *buffer, size_t size) {
+    if (mCount == 0) {
+      return 0;
+    }
+
+    const uint32_t length = mLengths[mHead] < size ? mLengths[mHead] : size;
+    memcpy(buffer, mDatagrams[mHead], length);
+
+    mHead = (mHead + 1) % LOOPBACK_QUEUE;
+    mCount--;
+
+    return length;
+  }
+};
+
+static stream_receiver_config_t config = {
+  .protocol = streamSacn,
+  .universe = UNIVERSE,
+  .timeoutMs = TIMEOUT_MS,
+};
+
+static StreamReceiver *receiver;
+static LoopbackSocket *loopback;
+static uint8_t packet[STREAM_PACKET_MAX];
+static uint8_t output[8];
+
+static const uint8_t SLOTS[] = {10, 20, 30, 40};
+
+static uint32_t buildSacn(uint16_t universe, uint8_t sequence, uint8_t options, const uint8_t *slots, uint32_t length) {
+  static const uint8_t HEADER[] = {
+    0x00, 0x10, 0x00, 0x00, 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0x00, 0x00, 0x00,
+    0x72, 0x6e, 0x00, 0x00, 0x00, 0x04,
+  };
+
+  memset(packet, 0, sizeof(packet));
+  memcpy(packet, HEADER, sizeof(HEADER));
+  packet[43] = 0x02;
+  packet[108] = 100;
+  packet[111] = sequence;
+  packet[112] = options;
+  packet[113] = universe >> 8;
+  packet[114] = universe & 0xFF;
+  packet[117] = 0x02;
+  packet[118] = 0xA1;
+  packet[122] = 0x01;
+  packet[123] = (length + 1) >> 8;
+  packet[124] = (length + 1) & 0xFF;
+  memcpy(&packet[126], slots, length);
+
+  return 126 + length;
+}
+
+static uint32_t buildArtNet(uint16_t portAddress, uint8_t sequence, const uint8_t *slots, uint32_t length) {
+  static const uint8_t HEADER[] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00, 0x00, 0x50, 0x00, 14};
+
+  memset(packet, 0, sizeof(packet));
+  memcpy(packet, HEADER, sizeof(HEADER));
+  packet[12] = sequence;
+  packet[14] = portAddress & 0xFF;
+  packet[15] = portAddress >> 8;
+  packet[16] = length >> 8;
+  packet[17] = length & 0xFF;
+  memcpy(&packet[18], slots, length);
+
+  return 18 + length;
+}
+
+static void sendSacn(uint8_t sequence, const uint8_t *slots = SLOTS, uint32_t length = sizeof(SLOTS)) {
+  loopback->send(packet, buildSacn(UNIVERSE, sequence, 0, slots, length));
+}
+
+TEST_GROUP(StreamReceiverTestGroup)
+{
+  void setup() {
+    config.protocol = streamSacn;
+    receiver = new StreamReceiver(&config);
+    loopback = new LoopbackSocket();
+    memset(output, 0xAA, sizeof(output));
+  }
+
+  void teardown() {
+    delete receiver;
+    delete loopback;
+  }
+};
+
+TEST(StreamReceiverTestGroup, ports)
+{
+  LONGS_EQUAL(5568, StreamReceiver::port(streamSacn));
+  LONGS_EQUAL(6454, StreamReceiver::port(streamArtNet));
+}
+
+TEST(StreamReceiverTestGroup, receivesSacnFrame)
+{
+  sendSacn(1);
+
+  LONGS_EQUAL(1, receiver->poll(loopback, 0));
+  LONGS_EQUAL(4, receiver->read(output, 0, 6));
+
+  const uint8_t expected[] = {10, 20, 30, 40, 0, 0, 0xAA};
+  for (uint32_t i=0; i<sizeof(expected); i++) {
+    BYTES_EQUAL(expected[i], output[i]);
+  }
+
+  CHECK_TRUE(receiver->isLive(0));
+}
+
+TEST(StreamReceiverTestGroup, readsFromFirstSlot)
+{
+  sendSacn(1);
+  receiver->poll(loopback, 0);
+
+  LONGS_EQUAL(2, receiver->read(output, 2, 2));
+  BYTES_EQUAL(30, output[0]);
+}
+
+TEST(StreamReceiverTestGroup, drainsSocket)
+{
+  const uint8_t later[] = {1, 2};
+  sendSacn(1);
+  sendSacn(2, later, sizeof(later));
+
+  LONGS_EQUAL(2, receiver->poll(loopback, 0));
+  LONGS_EQUAL(0, receiver->poll(loopback, 0));
+
+  LONGS_EQUAL(2, receiver->read(output, 0, 4));
+  BYTES_EQUAL(1, output[0]);
+  LONGS_EQUAL(2, receiver->stats()->packets);
+}
+
+TEST(StreamReceiverTestGroup, receivesFullUniverse)
+{
+  uint8_t slots[DMX_UNIVERSE_SLOTS];
+  for (uint32_t i=0; i<DMX_UNIVERSE_SLOTS; i++) {
+    slots[i] = i;
+  }
+
+  sendSacn(1, slots, DMX_UNIVERSE_SLOTS);
+
+  LONGS_EQUAL(1, receiver->poll(loopback, 0));
+  LONGS_EQUAL(1, receiver->read(output, DMX_UNIVERSE_SLOTS - 1, 4));
+  BYTES_EQUAL(255, output[0]);
+}
+
+TEST(StreamReceiverTestGroup, ignoresOtherUniverses)
+{
+  loopback->send(packet, buildSacn(UNIVERSE + 1, 1, 0, SLOTS, sizeof(SLOTS)));
+
+  LONGS_EQUAL(0, receiver->poll(loopback, 0));
+  LONGS_EQUAL(1, receiver->stats()->otherUniverses);
+  CHECK_FALSE(receiver->isLive(0));
+}
+
+TEST(StreamReceiverTestGroup, ignoresPreviewData)
+{
+  loopback->send(packet, buildSacn(UNIVERSE, 1, 0x80, SLOTS, sizeof(SLOTS)));
+
+  LONGS_EQUAL(0, receiver->poll(loopback, 0));
+}
+
+TEST(StreamReceiverTestGroup, rejectsBadPackets)
+{
+  const uint32_t length = buildSacn(UNIVERSE, 1, 0, SLOTS, sizeof(SLOTS));
+
+  //truncated
+  loopback->send(packet, 100);
+  //wrong identifier
+  packet[4] = 'X';
+  loopback->send(packet, length);
+  packet[4] = 'A';
+  //value count past the end of the datagram
+  packet[124] = 10;
+  loopback->send(packet, length);
+
+  LONGS_EQUAL(0, receiver->poll(loopback, 0));
+  LONGS_EQUAL(3, receiver->stats()->badPackets);
+}
+
+TEST(StreamReceiverTestGroup, dropsOutOfOrderFrames)
+{
+  const uint8_t older[] = {99};
+  sendSacn(10);
+  sendSacn(9, older, sizeof(older));
+  sendSacn(10, older, sizeof(older));
+
+  LONGS_EQUAL(1, receiver->poll(loopback, 0));
+  LONGS_EQUAL(2, receiver->stats()->outOfOrder);
+
+  receiver->read(output, 0, 1);
+  BYTES_EQUAL(10, output[0]);
+}
+
+TEST(StreamReceiverTestGroup, sequenceWraps)
+{
+  sendSacn(255);
+  sendSacn(0);
+
+  LONGS_EQUAL(2, receiver->poll(loopback, 0));
+}
+
+TEST(StreamReceiverTestGroup, farBehindIsRestart)
+{
+  sendSacn(100);
+  sendSacn(80);
+
+  LONGS_EQUAL(2, receiver->poll(loopback, 0));
+}
+
+TEST(StreamReceiverTestGroup, timesOut)
+{
+  sendSacn(1);
+  receiver->poll(loopback, 100);
+
+  CHECK_TRUE(receiver->isLive(100 + TIMEOUT_MS - 1));
+  CHECK_FALSE(receiver->isLive(100 + TIMEOUT_MS));
+}
+
+TEST(StreamReceiverTestGroup, acceptsAnySequenceAfterTimeout)
+{
+  sendSacn(50);
+  receiver->poll(loopback, 0);
+  sendSacn(49);
+
+  LONGS_EQUAL(1, receiver->poll(loopback, TIMEOUT_MS));
+}
+
+TEST(StreamReceiverTestGroup, streamTerminatedStopsNow)
+{
+  sendSacn(1);
+  receiver->poll(loopback, 0);
+  loopback->send(packet, buildSacn(UNIVERSE, 2, 0x40, SLOTS, sizeof(SLOTS)));
+  receiver->poll(loopback, 10);
+
+  CHECK_FALSE(receiver->isLive(10));
+
+  sendSacn(1);
+  LONGS_EQUAL(1, receiver->poll(loopback, 20));
+  CHECK_TRUE(receiver->isLive(20));
+}
+
+TEST(StreamReceiverTestGroup, receivesArtNetFrame)
+{
+  config.protocol = streamArtNet;
+  loopback->send(packet, buildArtNet(UNIVERSE, 1, SLOTS, sizeof(SLOTS)));
+
+  LONGS_EQUAL(1, receiver->poll(loopback, 0));
+  LONGS_EQUAL(4, receiver->read(output, 0, 4));
+  BYTES_EQUAL(40, output[3]);
+}
+
+TEST(StreamReceiverTestGroup, artNetPortAddress)
+{
+  config.protocol = streamArtNet;
+  loopback->send(packet, buildArtNet(UNIVERSE | 0x100, 1, SLOTS, sizeof(SLOTS)));
+
+  LONGS_EQUAL(0, receiver->poll(loopback, 0));
+  LONGS_EQUAL(1, receiver->stats()->otherUniverses);
+}
+
+TEST(StreamReceiverTestGroup, artNetSequenceZeroIsAlwaysInOrder)
+{
+  config.protocol = streamArtNet;
+  loopback->send(packet, buildArtNet(UNIVERSE, 10, SLOTS, sizeof(SLOTS)));
+  loopback->send(packet, buildArtNet(UNIVERSE, 0, SLOTS, sizeof(SLOTS)));
+  loopback->send(packet, buildArtNet(UNIVERSE, 0, SLOTS, sizeof(SLOTS)));
+
+  LONGS_EQUAL(3, receiver->poll(loopback, 0));
+}
+
+TEST(StreamReceiverTestGroup, rejectsOtherArtNetOpcodes)
+{
+  config.protocol = streamArtNet;
+  const uint32_t length = buildArtNet(UNIVERSE, 1, SLOTS, sizeof(SLOTS));
+  //ArtPoll
+  packet[9] = 0x20;
+  loopback->send(packet, length);
+
+  LONGS_EQUAL(0, receiver->poll(loopback, 0));
+  LONGS_EQUAL(1, receiver->stats()->badPackets);
+}
@@ -0,0 +1,294 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+#include <cstring>
+
+#include "colour.h"
+#include "colours.h"
+#include "ledStripDriver.h"
+#include "transition.h"
+#include "config.h"
+
+#define NUM_TEST_LEDS 2
+#define NUM_TEST_VALUES (NUM_TEST_LEDS * COLOURS_PER_LED)
+
+static uint8_t values[NUM_TEST_VALUES];
+static uint8_t outgoingValues[NUM_TEST_VALUES];
+static uint8_t lastValuesWritten[NUM_TEST_VALUES];
+
+static void writeValueStub(uint8_t *values, uint32_t length) {
+  memcpy(lastValuesWritten, values, length);
+}
+
+static led_strip_config_t config = {
+  .numLeds = NUM_TEST_LEDS,
+  .writeValueFn = writeValueStub,
+  .resolutionMs = 10,
+};
+
+static LedStripDriver *driver;
+static Transition *transition;
+static led_strip_state_t state;
+
+static const Colour COLOUR_FROM = Colour(200, 0, 0);
+static const Colour COLOUR_TO = Colour(0, 0, 100);
+
+TEST_GROUP(TransitionTestGroup)
+{
+  void setup() {
+    memset(values, 0, sizeof(values));
+    memset(outgoingValues, 0, sizeof(outgoingValues));
+    memset(lastValuesWritten, 0, sizeof(lastValuesWritten));
+
+    driver = new LedStripDriver(&config);
+    driver->initState(&state);
+    transition = new Transition(&config, outgoingValues);
+  }
+
+  void teardown() {
+    delete transition;
+    delete driver;
+  }
+};
+
+TEST(TransitionTestGroup, blendReturnsFromValuesForZeroAlpha)
+{
+  uint8_t blended[] = {255, 0, 10};
+  const uint8_t from[] = {0, 255, 20};
+
+  blendValues(blended, from, 3, 0);
+
+  BYTES_EQUAL(0, blended[0]);
+  BYTES_EQUAL(255, blended[1]);
+  BYTES_EQUAL(20, blended[2]);
+}
+
+TEST(TransitionTestGroup, blendReturnsValuesForMaxAlpha)
+{
+  uint8_t blended[] = {255, 0, 10};
+  const uint8_t from[] = {0, 255, 20};
+
+  blendValues(blended, from, 3, 256);
+
+  BYTES_EQUAL(255, blended[0]);
+  BYTES_EQUAL(0, blended[1]);
+  BYTES_EQUAL(10, blended[2]);
+}
+
+TEST(TransitionTestGroup, blendMixesValuesEquallyForHalfAlpha)
+{
+  uint8_t blended[] = {200, 0, 10};
+  const uint8_t from[] = {0, 100, 20};
+
+  blendValues(blended, from, 3, 128);
+
+  BYTES_EQUAL(100, blended[0]);
+  BYTES_EQUAL(50, blended[1]);
+  BYTES_EQUAL(15, blended[2]);
+}
+
+TEST(TransitionTestGroup, rendersIncomingPatternWhenInactive)
+{
+  driver->pattern(Pattern::colour)->colourOn((Colour*)&COLOUR_TO);
+
+  CHECK_FALSE(transition->isActive());
+  transition->onTimerFired(driver, &state, values);
+
+  BYTES_EQUAL(COLOUR_TO.getBlue(), lastValuesWritten[INDEX_BLUE]);
+  BYTES_EQUAL(COLOUR_TO.getRed(), lastValuesWritten[INDEX_RED]);
+}
+
+TEST(TransitionTestGroup, startsFromOutgoingPattern)
+{
+  driver->pattern(Pattern::colour)->colourOn((Colour*)&COLOUR_FROM);
+  transition->begin(driver, &state, values, 100);
+  driver->colourOn((Colour*)&COLOUR_TO);
+
+  transition->onTimerFired(driver, &state, values);
+
+  BYTES_EQUAL(COLOUR_FROM.getRed(), lastValuesWritten[INDEX_RED]);
+  BYTES_EQUAL(COLOUR_FROM.getBlue(), lastValuesWritten[INDEX_BLUE]);
+}
+
+TEST(TransitionTestGroup, blendsPatternsHalfwayThrough)
+{
+  driver->pattern(Pattern::colour)->colourOn((Colour*)&COLOUR_FROM);
+  transition->begin(driver, &state, values, 100);
+  driver->colourOn((Colour*)&COLOUR_TO);
+
+  for (uint32_t i=0; i < 6; i++) {
+    transition->onTimerFired(driver, &state, values);
+  }
+
+  BYTES_EQUAL(100, lastValuesWritten[INDEX_RED]);
+  BYTES_EQUAL(50, lastValuesWritten[INDEX_BLUE]);
+  BYTES_EQUAL(100, lastValuesWritten[COLOURS_PER_LED + INDEX_RED]);
+}
+
+TEST(TransitionTestGroup, endsOnIncomingPattern)
+{
+  driver->pattern(Pattern::colour)->colourOn((Colour*)&COLOUR_FROM);
+  transition->begin(driver, &state, values, 100);
+  driver->colourOn((Colour*)&COLOUR_TO);
+
+  for (uint32_t i=0; i < 11; i++) {
+    transition->onTimerFired(driver, &state, values);
+  }
+
+  CHECK_FALSE(transition->isActive());
+  BYTES_EQUAL(COLOUR_TO.getRed(), lastValuesWritten[INDEX_RED]);
+  BYTES_EQUAL(COLOUR_TO.getBlue(), lastValuesWritten[INDEX_BLUE]);
+}
+
+TEST(TransitionTestGroup, zeroDurationCutsImmediately)
+{
+  driver->pattern(Pattern::colour)->colourOn((Colour*)&COLOUR_FROM);
+  transition->begin(driver, &state, values, 0);
+  driver->colourOn((Colour*)&COLOUR_TO);
+
+  transition->onTimerFired(driver, &state, values);
+
+  BYTES_EQUAL(COLOUR_TO.getRed(), lastValuesWritten[INDEX_RED]);
+  BYTES_EQUAL(COLOUR_TO.getBlue(), lastValuesWritten[INDEX_BLUE]);
+}
+
+TEST(TransitionTestGroup, outgoingPatternKeepsItsColoursAfterTheyAreFreed)
+{
+  Colour *colour = new Colour(200, 0, 0);
+
+  driver->pattern(Pattern::colour)->colourOn(colour);
+  transition->begin(driver, &state, values, 100);
+  driver->colourOn((Colour*)&COLOUR_TO);
+
+  *colour = COLOUR_BLACK;
+  delete colour;
+
+  transition->onTimerFired(driver, &state, values);
+
+  BYTES_EQUAL(200, lastValuesWritten[INDEX_RED]);
+}
+
+TEST(TransitionTestGroup, outgoingPatternContinuesFromItsState)
+{
+  driver->pattern(Pattern::blink)
+    ->period(100)
+    ->dutyCycle(50)
+    ->colourOn((Colour*)&COLOUR_FROM)
+    ->colourOff((Colour*)&COLOUR_TO);
+
+  state.counter = 60;
+  transition->begin(driver, &state, values, 100);
+  driver->initState(&state);
+  driver->colourOff((Colour*)&COLOUR_FROM);
+
+  transition->onTimerFired(driver, &state, values);
+
+  //outgoing blink is in its off phase, incoming has restarted in its on phase
+  BYTES_EQUAL(COLOUR_TO.getBlue(), lastValuesWritten[INDEX_BLUE]);
+  LONGS_EQUAL(config.resolutionMs, state.counter);
+}
+
+TEST(TransitionTestGroup, fadesFromHeldFrameWhenInterrupted)
+{
+  const Colour colourNext = Colour(0, 100, 0);
+
+  driver->pattern(Pattern::colour)->colourOn((Colour*)&COLOUR_FROM);
+  transition->begin(driver, &state, values, 100);
+  driver->colourOn((Colour*)&COLOUR_TO);
+
+  for (uint32_t i=0; i < 6; i++) {
+    transition->onTimerFired(driver, &state, values);
+  }
+
+  transition->begin(driver, &state, values, 100);
+  driver->colourOn((Colour*)&colourNext);
+  transition->onTimerFired(driver, &state, values);
+
+  //carries on from the mix on the strip, not the pattern that was fading in
+  BYTES_EQUAL(100, lastValuesWritten[INDEX_RED]);
+  BYTES_EQUAL(0, lastValuesWritten[INDEX_GREEN]);
+  BYTES_EQUAL(50, lastValuesWritten[INDEX_BLUE]);
+
+  for (uint32_t i=0; i < 10; i++) {
+    transition->onTimerFired(driver, &state, values);
+  }
+
+  BYTES_EQUAL(0, lastValuesWritten[INDEX_RED]);
+  BYTES_EQUAL(100, lastValuesWritten[INDEX_GREEN]);
+}
+
+TEST(TransitionTestGroup, skippedFramesStepOutgoingPattern)
+{
+  driver->pattern(Pattern::blink)
+    ->period(100)
+    ->dutyCycle(50)
+    ->colourOn((Colour*)&COLOUR_FROM)
+    ->colourOff((Colour*)&COLOUR_TO);
+
+  state.counter = 40;
+  transition->begin(driver, &state, values, 100);
+  driver->initState(&state);
+  driver->colourOff((Colour*)&COLOUR_FROM);
+
+  transition->skipFrame();
+  transition->skipFrame();
+  transition->onTimerFired(driver, &state, values);
+
+  //outgoing blink has reached its off phase, 20ms into the fade
+  BYTES_EQUAL(39, lastValuesWritten[INDEX_RED]);
+  BYTES_EQUAL(80, lastValuesWritten[INDEX_BLUE]);
+}
+
+static uint32_t fakeTimeMs;
+
+static uint32_t fakeTime() {
+  return fakeTimeMs;
+}
+
+static led_strip_config_t configClocked = {
+  .numLeds = NUM_TEST_LEDS,
+  .writeValueFn = writeValueStub,
+  .resolutionMs = 10,
+  .timeFn = fakeTime,
+};
+
+TEST_GROUP(TransitionClockedTestGroup)
+{
+  void setup() {
+    memset(values, 0, sizeof(values));
+    memset(outgoingValues, 0, sizeof(outgoingValues));
+    memset(lastValuesWritten, 0, sizeof(lastValuesWritten));
+
+    fakeTimeMs = 1000;
+    driver = new LedStripDriver(&configClocked);
+    driver->initState(&state);
+    transition = new Transition(&configClocked, outgoingValues);
+  }
+
+  void teardown() {
+    delete transition;
+    delete driver;
+  }
+};
+
+TEST(TransitionClockedTestGroup, fadeKeepsTimeWhenFramesAreSkipped)
+{
+  driver->pattern(Pattern::colour)->colourOn((Colour*)&COLOUR_FROM);
+  transition->begin(driver, &state, values, 100);
+  driver->colourOn((Colour*)&COLOUR_TO);
+
+  transition->onTimerFired(driver, &state, values);
+
+  //a single late frame is half way through
+  fakeTimeMs += 50;
+  transition->onTimerFired(driver, &state, values);
+
+  BYTES_EQUAL(100, lastValuesWritten[INDEX_RED]);
+  BYTES_EQUAL(50, lastValuesWritten[INDEX_BLUE]);
+
+  fakeTimeMs += 50;
+  transition->onTimerFired(driver, &state, values);
+
+  CHECK_FALSE(transition->isActive());
+  BYTES_EQUAL(COLOUR_TO.getRed(), lastValuesWritten[INDEX_RED]);
+  BYTES_EQUAL(COLOUR_TO.getBlue(), lastValuesWritten[INDEX_BLUE]);
+}
@@ -34,6 +34,40 @@ TEST(HexStringToIntTestGroup, returnsCorrectResultForTwoChars)
     BYTES_EQUAL((uint8_t)245, hexStrToInt("F5"));
 }
 
+TEST(HexStringToIntTestGroup, returnsCorrectResultForMoreThanTwoChars)
+{
+    LONGS_EQUAL(0x1A2B3C, hexStrToInt("1a2B3c"));
+}
+
+TEST(HexStringToIntTestGroup, stopsAtFirstNonHexChar)
+{
+    LONGS_EQUAL(0xAB, hexStrToInt("ABG1"));
+}
+
+TEST_GROUP(HexDigitsToIntTestGroup) {
+
+};
+
+TEST(HexDigitsToIntTestGroup, convertsExactlyTheGivenDigits)
+{
+    uint32_t value = 0;
+    LONGS_EQUAL(0, hexDigitsToInt(&value, "12aBcDef", 6));
+    LONGS_EQUAL(0x12ABCD, value);
+}
+
+TEST(HexDigitsToIntTestGroup, returnsErrorAndLeavesValueForInvalidDigit)
+{
+    uint32_t value = 7;
+    LONGS_EQUAL(-1, hexDigitsToInt(&value, "12x456", 6));
+    LONGS_EQUAL(7, value);
+}
+
+TEST(HexDigitsToIntTestGroup, returnsErrorForShortString)
+{
+    uint32_t value = 0;
+    LONGS_EQUAL(-1, hexDigitsToInt(&value, "123", 6));
+}
+
 TEST_GROUP(StringToIntTestGroup) {
 
 };
@@ -63,3 +97,94 @@ TEST(StringToIntTestGroup, returnsErrorForEmptyString) {
   uint32_t value;
   LONGS_EQUAL(-1, strToInt(&value, ""));
 }
+
+TEST(StringToIntTestGroup, convertsLargestValue) {
+  uint32_t value;
+
+  LONGS_EQUAL(0, strToInt(&value, "4294967295"));
+  UNSIGNED_LONGS_EQUAL(4294967295u, value);
+}
+
+TEST(StringToIntTestGroup, returnsErrorAndSaturatesOnOverflow) {
+  const char *OVERFLOWING[] = {"4294967296", "4294967300", "4294967305", "5000000000", "9999999999", "10000000000"};
+
+  for (uint32_t i=0; i < sizeof(OVERFLOWING)/sizeof(OVERFLOWING[0]); i++) {
+    uint32_t value = 0;
+
+    LONGS_EQUAL(-1, strToInt(&value, OVERFLOWING[i]));
+    UNSIGNED_LONGS_EQUAL(UINT32_MAX, value);
+  }
+}
+
+TEST(StringToIntTestGroup, acceptsLeadingZerosBeyondTenDigits) {
+  uint32_t value;
+
+  LONGS_EQUAL(0, strToInt(&value, "000000000004294967295"));
+  UNSIGNED_LONGS_EQUAL(4294967295u, value);
+}
+
+TEST(StringToIntTestGroup, parsesOnlyTheGivenLength) {
+  uint32_t value;
+
+  LONGS_EQUAL(0, strToInt(&value, "1234,5678", 4));
+  LONGS_EQUAL(1234, value);
+}
+
+TEST(StringToIntTestGroup, convertsEveryLengthUpToTenDigits) {
+  char str[11] = "";
+  uint64_t expected = 0;
+
+  for (uint32_t len=1; len <= 10; len++) {
+    //all nines is the largest value of each length, ten nines overflows
+    str[len - 1] = '9';
+    str[len] = '\0';
+    expected = expected * 10 + 9;
+
+    uint32_t value;
+    const int32_t result = strToInt(&value, str);
+
+    LONGS_EQUAL(expected > UINT32_MAX ? -1 : 0, result);
+    UNSIGNED_LONGS_EQUAL(expected > UINT32_MAX ? UINT32_MAX : expected, value);
+  }
+}
+
+TEST(StringToIntTestGroup, rejectsEveryNonDigitInEveryPosition) {
+  char str[] = "1234567890";
+
+  for (uint32_t pos=0; pos < 10; pos++) {
+    for (int c=1; c < 256; c++) {
+      if (c >= '0' && c <= '9') {
+        continue;
+      }
+
+      str[pos] = (char)c;
+
+      uint32_t value;
+      LONGS_EQUAL(-1, strToInt(&value, str));
+    }
+    str[pos] = (char)('0' + (pos + 1) % 10);
+  }
+}
+
+TEST(StringToIntTestGroup, matchesReferenceForRandomNumbers) {
+  uint32_t seed = 54321;
+  char str[12];
+
+  for (int n=0; n < 50000; n++) {
+    seed = seed * 1103515245 + 12345;
+    const uint32_t len = 1 + (seed >> 16) % 11;
+
+    for (uint32_t i=0; i < len; i++) {
+      seed = seed * 1103515245 + 12345;
+      str[i] = (char)('0' + (seed >> 16) % 10);
+    }
+    str[len] = '\0';
+
+    const unsigned long long expected = strtoull(str, nullptr, 10);
+    uint32_t value;
+    const int32_t result = strToInt(&value, str);
+
+    LONGS_EQUAL(expected > UINT32_MAX ? -1 : 0, result);
+    UNSIGNED_LONGS_EQUAL(expected > UINT32_MAX ? UINT32_MAX : expected, value);
+  }
+}